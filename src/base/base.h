@@ -158,6 +158,7 @@ class Implementation {
     template <typename T>
     StatWrapper<T>& register_stat(std::vector<T>& val) { StatWrapper<T>* s = new StatWrapper<T>(val, *this, m_stats); return *s; };
     bool has_stats() { return !m_stats.is_empty(); };
+    const Stats& get_stats() const { return m_stats; };
     /**
      * @brief    Recursively print the stats of myself and all my childs
      * 
@@ -191,6 +192,24 @@ class Implementation {
       emitter << YAML::Newline;
     };
 
+    /**
+     * @brief    Recursively emit the stats of myself and all my childs to a machine-readable sink
+     *
+     */
+    virtual void emit_stats(IStatsSink& sink) {
+      std::string key = get_ifce_name();
+      if (get_id() != "_default_id") {
+        key += fmt::format("[{}]", get_id());
+      }
+      sink.begin_group(key);
+        sink.add("impl", get_name());
+        m_stats.emit_to(sink);
+        for (auto child_impl : m_children) {
+          child_impl->emit_stats(sink);
+        }
+      sink.end_group();
+    };
+
     std::string get_id() const { return m_id; };
     void set_id(std::string id) { m_id = id; };
 
@@ -283,6 +302,8 @@ class TopLevel {
     std::vector<Implementation*> m_components;
 
   public:
+    const std::vector<Implementation*>& get_components() const { return m_components; };
+
     void gather_components() {
       T* derived = static_cast<T*>(this);
       Implementation* impl = dynamic_cast<Implementation*>(derived);
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <string>
+#include <limits>
 
 #include "base/type.h"
 
@@ -23,10 +24,36 @@ class Clocked {
   public:
     virtual void tick() = 0;
 
+    /**
+     * @brief    Returns the earliest cycle at which tick() may do more than advancing the clock.
+     * @details
+     * Every tick() before the returned cycle must leave the object in the same state as fast_forward() would
+     * (no commands issued, no requests sent or served, no callbacks). A cycle that is not in the future 
+     * (e.g., m_clk + 1, the default) disables fast-forwarding over this object.
+     * 
+     */
+    virtual Clk_t get_next_event_cycle() { return m_clk + 1; };
+
+    /**
+     * @brief    Advances the object by num_cycles ticks that are known to be idle (see get_next_event_cycle()).
+     * 
+     */
+    virtual void fast_forward(Clk_t num_cycles) {
+      for (Clk_t i = 0; i < num_cycles; i++) {
+        tick();
+      }
+    };
+
   public:
     Clocked() {};
 };
 
+/**
+ * @brief    The next event cycle of an object that has nothing scheduled.
+ * 
+ */
+inline constexpr Clk_t NEVER_CLK = std::numeric_limits<Clk_t>::max();
+
 }        // namespace Ramulator
 
 
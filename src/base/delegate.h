@@ -0,0 +1,132 @@
+#ifndef     RAMULATOR_BASE_DELEGATE_H
+#define     RAMULATOR_BASE_DELEGATE_H
+
+#include <new>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <functional>
+#include <type_traits>
+
+#include "base/type.h"
+
+namespace Ramulator {
+
+template<typename Signature, size_t Capacity = 32>
+class Delegate;
+
+/**
+ * @brief    A non-allocating replacement of std::function.
+ * @details
+ * The callable is always stored in a fixed-size buffer inside the delegate, a callable that does
+ * not fit is rejected at compile time. Trivially copyable callables (e.g., lambdas capturing a
+ * few pointers) are copied with a memcpy. Other callables (e.g., a std::function handed over by
+ * an external simulator) are copied and destroyed through a type-erased manager.
+ *
+ */
+template<typename R, typename... Args, size_t Capacity>
+class Delegate<R(Args...), Capacity> {
+  private:
+    enum class ManageOp { Copy, Move, Destroy };
+
+    using Invoker_t = R(*)(void*, Args...);
+    using Manager_t = void(*)(ManageOp, void* dst, void* src);
+
+    alignas(std::max_align_t) std::byte m_storage[Capacity];
+    Invoker_t m_invoker = nullptr;
+    Manager_t m_manager = nullptr;    // nullptr if the stored callable is trivially copyable
+
+  public:
+    Delegate() = default;
+    Delegate(std::nullptr_t) {};
+
+    template<typename F, typename Fn = std::decay_t<F>>
+    requires (!std::is_same_v<Fn, Delegate> && std::is_invocable_r_v<R, Fn&, Args...>)
+    Delegate(F&& f) {
+      static_assert(sizeof(Fn) <= Capacity, "The callable does not fit in the storage of the Delegate!");
+      static_assert(alignof(Fn) <= alignof(std::max_align_t), "The callable is over-aligned for the Delegate!");
+
+      if constexpr (std::is_pointer_v<Fn> || std::is_member_pointer_v<Fn> || is_specialization_of_v<Fn, std::function>) {
+        // Keep empty callables empty
+        if (!f) {
+          return;
+        }
+      }
+
+      ::new (static_cast<void*>(m_storage)) Fn(std::forward<F>(f));
+      m_invoker = [](void* storage, Args... args) -> R {
+        return std::invoke(*static_cast<Fn*>(storage), std::forward<Args>(args)...);
+      };
+      if constexpr (!std::is_trivially_copyable_v<Fn>) {
+        m_manager = [](ManageOp op, void* dst, void* src) {
+          switch (op) {
+            case ManageOp::Copy:    ::new (dst) Fn(*static_cast<const Fn*>(src)); break;
+            case ManageOp::Move:    ::new (dst) Fn(std::move(*static_cast<Fn*>(src))); break;
+            case ManageOp::Destroy: static_cast<Fn*>(dst)->~Fn(); break;
+          }
+        };
+      }
+    };
+
+    Delegate(const Delegate& other) { copy_from(other); };
+    Delegate(Delegate&& other) noexcept { move_from(other); };
+
+    Delegate& operator=(const Delegate& other) {
+      if (this != &other) {
+        reset();
+        copy_from(other);
+      }
+      return *this;
+    };
+
+    Delegate& operator=(Delegate&& other) noexcept {
+      if (this != &other) {
+        reset();
+        move_from(other);
+      }
+      return *this;
+    };
+
+    Delegate& operator=(std::nullptr_t) { reset(); return *this; };
+
+    ~Delegate() { reset(); };
+
+    explicit operator bool() const { return m_invoker != nullptr; };
+
+    R operator()(Args... args) const {
+      return m_invoker(const_cast<std::byte*>(m_storage), std::forward<Args>(args)...);
+    };
+
+  private:
+    void reset() {
+      if (m_manager) {
+        m_manager(ManageOp::Destroy, m_storage, nullptr);
+      }
+      m_invoker = nullptr;
+      m_manager = nullptr;
+    };
+
+    void copy_from(const Delegate& other) {
+      if (other.m_manager) {
+        other.m_manager(ManageOp::Copy, m_storage, const_cast<std::byte*>(other.m_storage));
+      } else if (other.m_invoker) {
+        std::memcpy(m_storage, other.m_storage, Capacity);
+      }
+      m_invoker = other.m_invoker;
+      m_manager = other.m_manager;
+    };
+
+    void move_from(Delegate& other) {
+      if (other.m_manager) {
+        other.m_manager(ManageOp::Move, m_storage, other.m_storage);
+      } else if (other.m_invoker) {
+        std::memcpy(m_storage, other.m_storage, Capacity);
+      }
+      m_invoker = other.m_invoker;
+      m_manager = other.m_manager;
+    };
+};
+
+}        // namespace Ramulator
+
+#endif   // RAMULATOR_BASE_DELEGATE_H
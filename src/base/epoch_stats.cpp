@@ -0,0 +1,180 @@
+#include <algorithm>
+
+#include <spdlog/spdlog.h>
+
+#include "base/epoch_stats.h"
+#include "base/exception.h"
+
+namespace Ramulator {
+
+int EpochStats::add_stats(const Stats& stats, const std::string& prefix, const std::string& pattern, bool is_delta) {
+  bool is_prefix = !pattern.empty() && pattern.back() == '*';
+  std::string_view stem = is_prefix ? std::string_view(pattern).substr(0, pattern.size() - 1) : std::string_view(pattern);
+
+  std::vector<std::pair<std::string, const StatWrapperBase*>> matches;
+  stats.for_each([&](const std::string& stat_name, const StatWrapperBase* stat) {
+    if (!is_prefix && stat_name == stem) {
+      if (stat->get_num_values() == 0) {
+        throw ConfigurationError("Stat {}.{} is not arithmetic and cannot be sampled per epoch!", prefix, stat_name);
+      }
+      matches.push_back({stat_name, stat});
+    } else if (is_prefix && stat_name.starts_with(stem) && stat->get_num_values() > 0) {
+      // Non-arithmetic stats (e.g., histograms) are skipped by prefix matches
+      matches.push_back({stat_name, stat});
+    }
+  });
+  // The registry is unordered, keep the columns in a stable order
+  std::sort(matches.begin(), matches.end());
+
+  for (const auto& [stat_name, stat] : matches) {
+    size_t num_values = stat->get_num_values();
+    for (size_t i = 0; i < num_values; i++) {
+      std::string name = fmt::format("{}.{}", prefix, stat_name);
+      if (num_values > 1) {
+        name += fmt::format("[{}]", i);
+      }
+      m_columns.push_back({name, stat, i, is_delta});
+    }
+  }
+  return matches.size();
+}
+
+void EpochStats::open(const std::filesystem::path& path, const std::string& format) {
+  if (format == "binary") {
+    m_is_binary = true;
+  } else if (format != "csv") {
+    throw ConfigurationError("Unrecognized epoch stats format \"{}\" (expected csv or binary)!", format);
+  }
+
+  if (path.has_parent_path()) {
+    std::filesystem::create_directories(path.parent_path());
+  }
+  m_output.open(path, m_is_binary ? std::ios::binary : std::ios::out);
+  if (!m_output.is_open()) {
+    throw ConfigurationError("Cannot open epoch stats file {}!", path.string());
+  }
+  write_header();
+
+  for (auto& block : m_blocks) {
+    block.cycles.resize(BlockSize);
+    block.values.resize(BlockSize * m_columns.size());
+  }
+  // Deltas are relative to the values at the start of the simulation
+  for (auto& column : m_columns) {
+    column.last_value = column.stat->get_value(column.index);
+  }
+  m_writer = std::thread([this]() { writer_loop(); });
+}
+
+void EpochStats::sample(Clk_t clk) {
+  Block& block = m_blocks[m_active_block];
+  size_t row = block.num_rows;
+  block.cycles[row] = clk;
+  for (size_t c = 0; c < m_columns.size(); c++) {
+    Column& column = m_columns[c];
+    double value = column.stat->get_value(column.index);
+    block.values[c * BlockSize + row] = column.is_delta ? value - column.last_value : value;
+    column.last_value = value;
+  }
+  block.num_rows++;
+  m_last_sample_clk = clk;
+
+  if (block.num_rows == BlockSize) {
+    hand_over_active_block();
+  }
+}
+
+void EpochStats::close(Clk_t clk) {
+  if (!m_output.is_open()) {
+    return;
+  }
+  if (clk > m_last_sample_clk) {
+    sample(clk);
+  }
+  if (m_blocks[m_active_block].num_rows > 0) {
+    hand_over_active_block();
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop_writer = true;
+  }
+  m_cv.notify_all();
+  m_writer.join();
+  m_output.close();
+}
+
+void EpochStats::hand_over_active_block() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  // The other block is free once the writer is done with it
+  m_cv.wait(lock, [this]() { return m_full_block == nullptr; });
+  m_full_block = &m_blocks[m_active_block];
+  m_active_block = 1 - m_active_block;
+  lock.unlock();
+  m_cv.notify_all();
+}
+
+void EpochStats::writer_loop() {
+  while (true) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this]() { return m_full_block != nullptr || m_stop_writer; });
+    if (m_full_block == nullptr) {
+      return;
+    }
+    Block* block = m_full_block;
+    lock.unlock();
+
+    write_block(*block);
+    block->num_rows = 0;
+
+    lock.lock();
+    m_full_block = nullptr;
+    lock.unlock();
+    m_cv.notify_all();
+  }
+}
+
+void EpochStats::write_header() {
+  if (m_is_binary) {
+    uint32_t version = 1;
+    uint32_t num_columns = m_columns.size();
+    m_output.write("RAMEPOCH", 8);
+    m_output.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    m_output.write(reinterpret_cast<const char*>(&num_columns), sizeof(num_columns));
+    for (const auto& column : m_columns) {
+      uint8_t is_delta = column.is_delta;
+      uint32_t name_length = column.name.size();
+      m_output.write(reinterpret_cast<const char*>(&is_delta), sizeof(is_delta));
+      m_output.write(reinterpret_cast<const char*>(&name_length), sizeof(name_length));
+      m_output.write(column.name.data(), name_length);
+    }
+  } else {
+    m_output << "cycle";
+    for (const auto& column : m_columns) {
+      m_output << "," << column.name;
+    }
+    m_output << "\n";
+  }
+}
+
+void EpochStats::write_block(const Block& block) {
+  if (m_is_binary) {
+    uint32_t num_rows = block.num_rows;
+    m_output.write(reinterpret_cast<const char*>(&num_rows), sizeof(num_rows));
+    m_output.write(reinterpret_cast<const char*>(block.cycles.data()), num_rows * sizeof(uint64_t));
+    for (size_t c = 0; c < m_columns.size(); c++) {
+      m_output.write(reinterpret_cast<const char*>(&block.values[c * BlockSize]), num_rows * sizeof(double));
+    }
+  } else {
+    fmt::memory_buffer buffer;
+    for (size_t row = 0; row < block.num_rows; row++) {
+      fmt::format_to(std::back_inserter(buffer), "{}", block.cycles[row]);
+      for (size_t c = 0; c < m_columns.size(); c++) {
+        fmt::format_to(std::back_inserter(buffer), ",{}", block.values[c * BlockSize + row]);
+      }
+      buffer.push_back('\n');
+    }
+    m_output.write(buffer.data(), buffer.size());
+  }
+}
+
+}        // namespace Ramulator
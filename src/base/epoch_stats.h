@@ -0,0 +1,101 @@
+#ifndef     RAMULATOR_BASE_EPOCH_STATS_H
+#define     RAMULATOR_BASE_EPOCH_STATS_H
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <filesystem>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "base/type.h"
+#include "base/stats.h"
+
+
+namespace Ramulator {
+
+/**
+ * @brief     Samples registered stats every epoch into a time-series file.
+ * @details
+ * Each column is one value of an arithmetic stat, sampled either as a gauge (its value at the end of the epoch)
+ * or as a delta (its change over the epoch). Samples are buffered in blocks of BlockSize rows on the simulation
+ * thread. A full block is handed to a writer thread while the simulation fills the other block, so the simulation
+ * only waits if the writer falls a whole block behind.
+ *
+ * The CSV format has one row per epoch: "cycle,<column>,...".
+ * The binary format is columnar: the header is "RAMEPOCH", uint32 version, uint32 number of columns, and for each
+ * column a uint8 (1 for deltas), a uint32 name length and the name. Each block follows as a uint32 number of rows,
+ * the uint64 cycles of the rows, and then the double values of each column in turn.
+ *
+ */
+class EpochStats {
+  public:
+    static constexpr size_t BlockSize = 1024;
+
+  private:
+    struct Column {
+      std::string name;
+      const StatWrapperBase* stat;
+      size_t index;
+      bool is_delta;
+      double last_value = 0.0;
+    };
+
+    struct Block {
+      std::vector<uint64_t> cycles;
+      std::vector<double> values;     // Column-major, BlockSize rows per column
+      size_t num_rows = 0;
+    };
+
+    std::vector<Column> m_columns;
+    std::ofstream m_output;
+    bool m_is_binary = false;
+    Clk_t m_last_sample_clk = 0;
+
+    Block m_blocks[2];
+    int m_active_block = 0;
+
+    std::thread m_writer;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    Block* m_full_block = nullptr;    // The block handed to the writer thread, nullptr once written
+    bool m_stop_writer = false;
+
+  public:
+    ~EpochStats() { close(m_last_sample_clk); };
+
+    /**
+     * @brief    Adds a column for every value of the stats whose names match pattern (exactly, or by prefix if it ends with '*').
+     * @details  The columns are named "<prefix>.<stat name>", with "[<index>]" appended for the elements of vector stats.
+     *
+     * @return   The number of stats that match.
+     */
+    int add_stats(const Stats& stats, const std::string& prefix, const std::string& pattern, bool is_delta);
+
+    void open(const std::filesystem::path& path, const std::string& format);
+    bool is_open() const { return m_output.is_open(); };
+
+    /**
+     * @brief    Records one row for the epoch ending at clk.
+     *
+     */
+    void sample(Clk_t clk);
+
+    /**
+     * @brief    Records the last (partial) epoch ending at clk, writes all buffered rows, and closes the file.
+     *
+     */
+    void close(Clk_t clk);
+
+  private:
+    void hand_over_active_block();
+    void writer_loop();
+    void write_header();
+    void write_block(const Block& block);
+};
+
+}        // namespace Ramulator
+
+
+#endif   // RAMULATOR_BASE_EPOCH_STATS_H
@@ -0,0 +1,159 @@
+#ifndef     RAMULATOR_BASE_HISTOGRAM_H
+#define     RAMULATOR_BASE_HISTOGRAM_H
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <string>
+#include <algorithm>
+
+#include <yaml-cpp/yaml.h>
+
+#include "base/stats_sink.h"
+
+
+namespace Ramulator {
+
+/**
+ * @brief     A log-linear (HDR-style) histogram of non-negative integer values, e.g., latencies in cycles.
+ * @details
+ * Values below 2^SubBucketBits are counted exactly. Above that, every power of two is split into
+ * 2^(SubBucketBits-1) equal buckets, so a value is known within 2^(1-SubBucketBits) of itself (~3%).
+ * Values are clamped to 2^MaxBits-1. The buckets are a fixed array: recording never allocates.
+ * Registered with register_stat(), it is emitted as its count, mean, min, max, and p50/p90/p99/p99.9.
+ *
+ */
+class LatencyHistogram {
+  public:
+    static constexpr int SubBucketBits = 6;
+    static constexpr int MaxBits = 40;
+
+  private:
+    static constexpr uint64_t SubBucketCount = uint64_t(1) << SubBucketBits;
+    static constexpr uint64_t HalfBucketCount = SubBucketCount / 2;
+    static constexpr uint64_t MaxValue = (uint64_t(1) << MaxBits) - 1;
+    static constexpr size_t NumBuckets = SubBucketCount + (MaxBits - SubBucketBits) * HalfBucketCount;
+
+    std::array<uint64_t, NumBuckets> m_buckets{};
+    uint64_t m_count = 0;
+    uint64_t m_sum = 0;
+    uint64_t m_min = UINT64_MAX;
+    uint64_t m_max = 0;
+
+  public:
+    void record(int64_t value, uint64_t count = 1) {
+      uint64_t v = std::min(static_cast<uint64_t>(std::max<int64_t>(value, 0)), MaxValue);
+      m_buckets[get_bucket(v)] += count;
+      m_count += count;
+      m_sum += v * count;
+      m_min = std::min(m_min, v);
+      m_max = std::max(m_max, v);
+    };
+
+    void merge(const LatencyHistogram& other) {
+      for (size_t i = 0; i < NumBuckets; i++) {
+        m_buckets[i] += other.m_buckets[i];
+      }
+      m_count += other.m_count;
+      m_sum += other.m_sum;
+      m_min = std::min(m_min, other.m_min);
+      m_max = std::max(m_max, other.m_max);
+    };
+
+    uint64_t count() const { return m_count; };
+    uint64_t min() const { return m_count ? m_min : 0; };
+    uint64_t max() const { return m_max; };
+    double mean() const { return m_count ? (double) m_sum / m_count : 0.0; };
+
+    /**
+     * @brief     Returns the smallest recorded value (up to the bucket resolution) that at least percentile% of the values do not exceed.
+     *
+     */
+    uint64_t get_percentile(double percentile) const {
+      if (m_count == 0) {
+        return 0;
+      }
+      uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(percentile / 100.0 * m_count + 0.5));
+      uint64_t seen = 0;
+      for (size_t i = 0; i < NumBuckets; i++) {
+        seen += m_buckets[i];
+        if (seen >= rank) {
+          return std::clamp(get_bucket_upper(i), min(), max());
+        }
+      }
+      return m_max;
+    };
+
+    /**
+     * @brief     Calls fn(lower, upper, count) for every non-empty bucket, in increasing order of values.
+     *
+     */
+    template <typename Fn>
+    void for_each_bucket(Fn&& fn) const {
+      for (size_t i = 0; i < NumBuckets; i++) {
+        if (m_buckets[i]) {
+          fn(get_bucket_lower(i), get_bucket_upper(i), m_buckets[i]);
+        }
+      }
+    };
+
+  private:
+    static size_t get_bucket(uint64_t v) {
+      if (v < SubBucketCount) {
+        return v;
+      }
+      // v is in [2^msb, 2^(msb+1)), its top SubBucketBits bits select one of the HalfBucketCount buckets of this range
+      int msb = std::bit_width(v) - 1;
+      int shift = msb - SubBucketBits + 1;
+      return SubBucketCount + (msb - SubBucketBits) * HalfBucketCount + ((v >> shift) - HalfBucketCount);
+    };
+
+    static uint64_t get_bucket_lower(size_t bucket) {
+      if (bucket < SubBucketCount) {
+        return bucket;
+      }
+      size_t range = (bucket - SubBucketCount) / HalfBucketCount;
+      size_t sub_bucket = (bucket - SubBucketCount) % HalfBucketCount;
+      return (HalfBucketCount + sub_bucket) << (range + 1);
+    };
+
+    static uint64_t get_bucket_upper(size_t bucket) {
+      if (bucket < SubBucketCount) {
+        return bucket;
+      }
+      size_t range = (bucket - SubBucketCount) / HalfBucketCount;
+      return get_bucket_lower(bucket) + (uint64_t(1) << (range + 1)) - 1;
+    };
+};
+
+inline YAML::Emitter& operator << (YAML::Emitter& emitter, const LatencyHistogram& histogram) {
+  emitter << YAML::BeginMap;
+  emitter << YAML::Key << "count" << YAML::Value << histogram.count();
+  emitter << YAML::Key << "mean"  << YAML::Value << histogram.mean();
+  emitter << YAML::Key << "min"   << YAML::Value << histogram.min();
+  emitter << YAML::Key << "max"   << YAML::Value << histogram.max();
+  emitter << YAML::Key << "p50"   << YAML::Value << histogram.get_percentile(50);
+  emitter << YAML::Key << "p90"   << YAML::Value << histogram.get_percentile(90);
+  emitter << YAML::Key << "p99"   << YAML::Value << histogram.get_percentile(99);
+  emitter << YAML::Key << "p99.9" << YAML::Value << histogram.get_percentile(99.9);
+  emitter << YAML::EndMap;
+  return emitter;
+}
+
+inline void emit_stat(IStatsSink& sink, const std::string& key, const LatencyHistogram& histogram) {
+  sink.begin_group(key);
+  sink.add("count", static_cast<int64_t>(histogram.count()));
+  sink.add("mean",  histogram.mean());
+  sink.add("min",   static_cast<int64_t>(histogram.min()));
+  sink.add("max",   static_cast<int64_t>(histogram.max()));
+  sink.add("p50",   static_cast<int64_t>(histogram.get_percentile(50)));
+  sink.add("p90",   static_cast<int64_t>(histogram.get_percentile(90)));
+  sink.add("p99",   static_cast<int64_t>(histogram.get_percentile(99)));
+  sink.add("p99.9", static_cast<int64_t>(histogram.get_percentile(99.9)));
+  sink.end_group();
+}
+
+}        // namespace Ramulator
+
+
+#endif   // RAMULATOR_BASE_HISTOGRAM_H
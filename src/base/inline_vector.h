@@ -0,0 +1,104 @@
+#ifndef     RAMULATOR_BASE_INLINE_VECTOR_H
+#define     RAMULATOR_BASE_INLINE_VECTOR_H
+
+#include <array>
+#include <iterator>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <initializer_list>
+
+namespace Ramulator {
+
+/**
+ * @brief    A vector with a fixed capacity whose elements are stored inline.
+ * @details
+ * Provides the subset of the std::vector interface that is used on address vectors, but never
+ * allocates: copying an InlineVector is a plain copy of its storage. Growing it beyond its
+ * capacity throws std::length_error.
+ *
+ */
+template<typename T, size_t Capacity>
+class InlineVector {
+  static_assert(std::is_trivially_copyable_v<T>, "InlineVector only holds trivially copyable elements!");
+
+  public:
+    using value_type      = T;
+    using size_type       = size_t;
+    using reference       = T&;
+    using const_reference = const T&;
+    using iterator        = T*;
+    using const_iterator  = const T*;
+
+  private:
+    std::array<T, Capacity> m_data {};
+    size_type m_size = 0;
+
+  public:
+    InlineVector() = default;
+    explicit InlineVector(size_type count, const T& value = T()) { resize(count, value); };
+    InlineVector(std::initializer_list<T> init) { assign(init.begin(), init.end()); };
+    template<std::input_iterator InputIt>
+    InlineVector(InputIt first, InputIt last) { assign(first, last); };
+    InlineVector(const std::vector<T>& vec) { assign(vec.begin(), vec.end()); };
+
+    static constexpr size_type capacity() { return Capacity; };
+    size_type size() const { return m_size; };
+    bool empty() const { return m_size == 0; };
+
+    T& operator[](size_type pos) { return m_data[pos]; };
+    const T& operator[](size_type pos) const { return m_data[pos]; };
+    T& front() { return m_data[0]; };
+    const T& front() const { return m_data[0]; };
+    T& back() { return m_data[m_size - 1]; };
+    const T& back() const { return m_data[m_size - 1]; };
+    T* data() { return m_data.data(); };
+    const T* data() const { return m_data.data(); };
+
+    iterator begin() { return m_data.data(); };
+    iterator end() { return m_data.data() + m_size; };
+    const_iterator begin() const { return m_data.data(); };
+    const_iterator end() const { return m_data.data() + m_size; };
+
+    void clear() { m_size = 0; };
+
+    void resize(size_type count, const T& value = T()) {
+      check_capacity(count);
+      if (count > m_size) {
+        std::fill(m_data.begin() + m_size, m_data.begin() + count, value);
+      }
+      m_size = count;
+    };
+
+    template<std::input_iterator InputIt>
+    void assign(InputIt first, InputIt last) {
+      m_size = 0;
+      for (; first != last; ++first) {
+        push_back(*first);
+      }
+    };
+
+    void push_back(const T& value) {
+      check_capacity(m_size + 1);
+      m_data[m_size++] = value;
+    };
+
+    void pop_back() { m_size--; };
+
+    operator std::vector<T>() const { return std::vector<T>(begin(), end()); };
+
+    friend bool operator==(const InlineVector& lhs, const InlineVector& rhs) {
+      return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    };
+
+  private:
+    static void check_capacity(size_type count) {
+      if (count > Capacity) {
+        throw std::length_error("InlineVector capacity exceeded!");
+      }
+    };
+};
+
+}        // namespace Ramulator
+
+#endif   // RAMULATOR_BASE_INLINE_VECTOR_H
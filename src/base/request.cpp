@@ -1,13 +1,137 @@
 #include "base/request.h"
 
+#include <algorithm>
+#include <stdexcept>
+
 namespace Ramulator {
 
 Request::Request(Addr_t addr, int type): addr(addr), type_id(type) {};
 
-Request::Request(AddrVec_t addr_vec, int type): addr_vec(addr_vec), type_id(type) {};
+Request::Request(const AddrVec_t& addr_vec, int type): addr_vec(addr_vec), type_id(type) {};
+
+Request::Request(Addr_t addr, int type, int source_id, Callback_t callback):
+addr(addr), type_id(type), source_id(source_id), callback(std::move(callback)) {};
+
+void ReqBuffer::enable_bank_index(int bank_level, int row_level, const std::vector<int>& level_sizes) {
+  if (m_size != 0) {
+    throw std::runtime_error("Cannot index a non-empty request buffer!");
+  }
+  m_bank_level = bank_level;
+  m_row_level = row_level;
+  m_level_sizes = level_sizes;
+
+  int num_banks = 1;
+  for (int level = 0; level <= bank_level; level++) {
+    num_banks *= level_sizes[level];
+  }
+  m_banks.resize(num_banks + 1);
+};
+
+void ReqBuffer::link_to_group(Node* node) {
+  const Request& req = node->req;
+  int bank_id = get_bank_id(req.addr_vec);
+  int bank_slot = (bank_id == -1) ? m_banks.size() - 1 : bank_id;
+  BankSlot& bank = m_banks[bank_slot];
+  bank.size++;
+
+  // Find the row group of the request among the groups of its bank
+  size_t row_addr_len = std::min<size_t>(m_row_level + 1, req.addr_vec.size());
+  RowGroup* group = bank.groups;
+  while (group) {
+    if (group->final_command == req.final_command && 
+        std::equal(group->row_addr_vec.begin(), group->row_addr_vec.end(), req.addr_vec.begin(), req.addr_vec.begin() + row_addr_len)) {
+      break;
+    }
+    group = group->bank_next;
+  }
+
+  if (!group) {
+    if (m_free_groups) {
+      group = m_free_groups;
+      m_free_groups = group->next;
+    } else {
+      group = &m_group_pool.emplace_back();
+    }
+    group->final_command = req.final_command;
+    group->row_addr_vec.assign(req.addr_vec.begin(), req.addr_vec.begin() + row_addr_len);
+    group->bank_slot = bank_slot;
+    group->first = group->last = nullptr;
+    group->cache = GroupCache();
+
+    group->bank_prev = nullptr;
+    group->bank_next = bank.groups;
+    if (bank.groups) {
+      bank.groups->bank_prev = group;
+    }
+    bank.groups = group;
+
+    group->prev = m_group_head.prev;
+    group->next = &m_group_head;
+    m_group_head.prev->next = group;
+    m_group_head.prev = group;
+  }
+
+  // Keep the members ordered by arrival, and by enqueue order among equal arrivals
+  Node* after = group->last;
+  while (after && after->req.arrive > req.arrive) {
+    after = after->group_prev;
+  }
+  Node* before = after ? after->group_next : group->first;
+  node->group_prev = after;
+  node->group_next = before;
+  // Only the command of the oldest request is kept up to date, clear the others so that stale commands are never read
+  if (after) {
+    after->group_next = node;
+    node->req.command = -1;
+  } else {
+    if (before) {
+      before->req.command = -1;
+    }
+    group->first = node;
+  }
+  if (before) {
+    before->group_prev = node;
+  } else {
+    group->last = node;
+  }
+  node->group = group;
+};
+
+void ReqBuffer::unlink_from_group(Node* node) {
+  RowGroup* group = node->group;
+  if (node->group_prev) {
+    node->group_prev->group_next = node->group_next;
+  } else {
+    group->first = node->group_next;
+  }
+  if (node->group_next) {
+    node->group_next->group_prev = node->group_prev;
+  } else {
+    group->last = node->group_prev;
+  }
+  node->group = nullptr;
+  node->group_prev = node->group_next = nullptr;
+
+  BankSlot& bank = m_banks[group->bank_slot];
+  bank.size--;
 
-Request::Request(Addr_t addr, int type, int source_id, std::function<void(Request&)> callback):
-addr(addr), type_id(type), source_id(source_id), callback(callback) {};
+  if (!group->first) {
+    // The group is empty, recycle it
+    if (group->bank_prev) {
+      group->bank_prev->bank_next = group->bank_next;
+    } else {
+      bank.groups = group->bank_next;
+    }
+    if (group->bank_next) {
+      group->bank_next->bank_prev = group->bank_prev;
+    }
+    group->prev->next = group->next;
+    group->next->prev = group->prev;
+    group->prev = nullptr;
+    group->next = m_free_groups;
+    m_free_groups = group;
+  }
+};
 
 }        // namespace Ramulator
 
@@ -1,14 +1,19 @@
 #ifndef     RAMULATOR_BASE_REQUEST_H
 #define     RAMULATOR_BASE_REQUEST_H
 
-#include <list>
+#include <deque>
+#include <iterator>
+#include <vector>
 #include <string>
 
 #include "base/base.h"
+#include "base/delegate.h"
 
 namespace Ramulator {
 
 struct Request {
+  using Callback_t = Delegate<void(Request&)>;
+
   Addr_t    addr = -1;
   AddrVec_t addr_vec {};
 
@@ -37,37 +42,243 @@ struct Request {
 
   std::array<int, 4> scratchpad = { 0 };    // A scratchpad for the request
 
-  std::function<void(Request&)> callback;
+  Callback_t callback;      // Called by the memory system when the request is served
 
   void* m_payload = nullptr;    // Point to a generic payload
 
   Request(Addr_t addr, int type);
-  Request(AddrVec_t addr_vec, int type);
-  Request(Addr_t addr, int type, int source_id, std::function<void(Request&)> callback);
+  Request(const AddrVec_t& addr_vec, int type);
+  Request(Addr_t addr, int type, int source_id, Callback_t callback);
 };
 
+/**
+ * @brief    A FIFO request buffer backed by a pool of recycled nodes.
+ * @details
+ * Requests are kept in an intrusive doubly-linked list whose nodes are allocated from a pool
+ * owned by the buffer. Removed nodes go to a free list and are reused by later enqueues, so
+ * the buffer stops allocating once it has reached its peak occupancy. Like the std::list it 
+ * replaces, iterators stay valid until the request they point to is removed.
+ * 
+ * Optionally, the buffer also indexes its requests by bank and by row (see enable_bank_index()).
+ * Requests to the same row with the same final command form a row group: the device cannot tell
+ * them apart when resolving prerequisite commands and timing, so a scheduler only needs to look
+ * at the oldest request of each group. The command of the other requests in a group is reset to -1
+ * and is resolved again once the request becomes the oldest one.
+ * 
+ */
 struct ReqBuffer {
-  std::list<Request> buffer;
-  size_t max_size = 32;
+  public:
+    /**
+     * @brief    Scheduler-owned data attached to a row group, reset whenever a new group is formed.
+     * 
+     */
+    struct GroupCache {
+      bool is_valid = false;        // Whether command is up to date
+      int command = -1;             // The prerequisite command of the requests in the group
+      bool is_ready_valid = false;  // Whether ready_clk is up to date
+      Clk_t ready_clk = -1;         // The earliest cycle at which command can be issued
+      uint64_t ready_epoch = 0;     // When ready_clk was last computed
+    };
+
+  private:
+    struct RowGroup;
+
+    struct Node {
+      Request req = {-1, -1};
+      Node* prev = nullptr;
+      Node* next = nullptr;
+
+      uint64_t seq = 0;                 // Enqueue order of the request
+      RowGroup* group = nullptr;        // The row group of the request, if the buffer is bank-indexed
+      Node* group_prev = nullptr;
+      Node* group_next = nullptr;
+    };
+
+    struct RowGroup {
+      int final_command = -1;
+      AddrVec_t row_addr_vec;           // Address of the row (levels below the row are dropped)
+      int bank_slot = -1;
+      Node* first = nullptr;            // Members ordered by arrival, the oldest first
+      Node* last = nullptr;
+      RowGroup* prev = nullptr;         // Circular list of all row groups
+      RowGroup* next = nullptr;
+      RowGroup* bank_prev = nullptr;    // List of the row groups of the same bank
+      RowGroup* bank_next = nullptr;
+      GroupCache cache;
+    };
+
+    struct BankSlot {
+      size_t size = 0;
+      RowGroup* groups = nullptr;
+    };
 
-  using iterator = std::list<Request>::iterator;
-  iterator begin() { return buffer.begin(); };
-  iterator end() { return buffer.end(); };
+    std::deque<Node> m_pool;      // Storage of all nodes ever allocated (std::deque never moves its elements)
+    Node m_head;                  // Sentinel of the circular list of queued requests, end() points here
+    Node* m_free_list = nullptr;  // Singly-linked (through next) list of recycled nodes
+    size_t m_size = 0;
+    uint64_t m_next_seq = 0;
+
+    int m_bank_level = -1;                  // Bank index is disabled if -1
+    int m_row_level = -1;
+    std::vector<int> m_level_sizes;
+    std::vector<BankSlot> m_banks;          // One slot per bank, plus a last one for requests not addressed to a single bank
+    std::deque<RowGroup> m_group_pool;
+    RowGroup m_group_head;                  // Sentinel of the circular list of row groups
+    RowGroup* m_free_groups = nullptr;
+
+  public:
+    size_t max_size = 32;
+
+    class iterator {
+      friend struct ReqBuffer;
+
+      private:
+        Node* m_node = nullptr;
+        explicit iterator(Node* node): m_node(node) {};
+
+      public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = Request;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Request*;
+        using reference = Request&;
+
+        iterator() = default;
+
+        Request& operator*() const { return m_node->req; };
+        Request* operator->() const { return &m_node->req; };
+
+        iterator& operator++() { m_node = m_node->next; return *this; };
+        iterator operator++(int) { iterator it = *this; m_node = m_node->next; return it; };
+        iterator& operator--() { m_node = m_node->prev; return *this; };
+        iterator operator--(int) { iterator it = *this; m_node = m_node->prev; return it; };
+
+        bool operator==(const iterator& other) const { return m_node == other.m_node; };
+        bool operator!=(const iterator& other) const { return m_node != other.m_node; };
+    };
+
+  public:
+    ReqBuffer() { 
+      m_head.prev = m_head.next = &m_head; 
+      m_group_head.prev = m_group_head.next = &m_group_head;
+    };
+
+    // The sentinel is linked to itself, so a buffer cannot be copied or moved around
+    ReqBuffer(const ReqBuffer&) = delete;
+    ReqBuffer& operator=(const ReqBuffer&) = delete;
+
+    iterator begin() { return iterator(m_head.next); };
+    iterator end() { return iterator(&m_head); };
+
+    size_t size() const { return m_size; }
+
+    bool enqueue(const Request& request) {
+      if (m_size <= max_size) {
+        Node* node = allocate_node();
+        node->req = request;
+        node->seq = m_next_seq++;
+        node->prev = m_head.prev;
+        node->next = &m_head;
+        m_head.prev->next = node;
+        m_head.prev = node;
+        m_size++;
+        if (is_bank_indexed()) {
+          link_to_group(node);
+        }
+        return true;
+      } else {
+        return false;
+      }
+    }
+
+    void remove(iterator it) {
+      Node* node = it.m_node;
+      if (is_bank_indexed()) {
+        unlink_from_group(node);
+      }
+      node->prev->next = node->next;
+      node->next->prev = node->prev;
+      node->prev = nullptr;
+      node->next = m_free_list;
+      m_free_list = node;
+      m_size--;
+    }
+
+    /**
+     * @brief    Index the requests by bank and by row group.
+     * 
+     * @param    bank_level     The level of the bank in the address vector.
+     * @param    row_level      The level of the row in the address vector.
+     * @param    level_sizes    The number of nodes at each level (at least down to the bank).
+     */
+    void enable_bank_index(int bank_level, int row_level, const std::vector<int>& level_sizes);
+
+    bool is_bank_indexed() const { return m_bank_level != -1; };
+
+    /**
+     * @brief    Returns the flat id of the bank addressed by the address vector, or -1 if it does not address a single bank.
+     * 
+     */
+    int get_bank_id(const AddrVec_t& addr_vec) const {
+      int bank_id = 0;
+      for (int level = 0; level <= m_bank_level; level++) {
+        if (addr_vec[level] < 0) {
+          return -1;
+        }
+        bank_id = bank_id * m_level_sizes[level] + addr_vec[level];
+      }
+      return bank_id;
+    };
+
+    /**
+     * @brief    Returns the number of queued requests to the bank (-1 for requests not addressed to a single bank).
+     * 
+     */
+    size_t get_bank_size(int bank_id) const {
+      return bank_id == -1 ? m_banks.back().size : m_banks[bank_id].size;
+    };
+
+    /**
+     * @brief    Calls f with (an iterator to) the oldest request of each row group and the cache of the group.
+     * 
+     */
+    template<typename F>
+    void for_each_group_head(F&& f) {
+      for (RowGroup* group = m_group_head.next; group != &m_group_head; group = group->next) {
+        f(iterator(group->first), group->cache);
+      }
+    };
+
+    /**
+     * @brief    Calls f with (an iterator to) the oldest request of each row group of the bank.
+     * 
+     */
+    template<typename F>
+    void for_each_group_head_in_bank(int bank_id, F&& f) {
+      BankSlot& bank = bank_id == -1 ? m_banks.back() : m_banks[bank_id];
+      for (RowGroup* group = bank.groups; group != nullptr; group = group->bank_next) {
+        f(iterator(group->first), group->cache);
+      }
+    };
 
-  size_t size() const { return buffer.size(); }
+    /**
+     * @brief    Whether the request at it1 was enqueued before the one at it2.
+     * 
+     */
+    static bool is_enqueued_before(iterator it1, iterator it2) { return it1.m_node->seq < it2.m_node->seq; };
 
-  bool enqueue(const Request& request) {
-    if (buffer.size() <= max_size) {
-      buffer.push_back(request);
-      return true;
-    } else {
-      return false;
+  private:
+    Node* allocate_node() {
+      if (m_free_list) {
+        Node* node = m_free_list;
+        m_free_list = node->next;
+        return node;
+      }
+      return &m_pool.emplace_back();
     }
-  }
 
-  void remove(iterator it) {
-    buffer.erase(it);
-  }
+    void link_to_group(Node* node);
+    void unlink_from_group(Node* node);
 };
 
 }        // namespace Ramulator
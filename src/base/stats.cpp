@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "base/stats.h"
 
 namespace Ramulator {
@@ -9,4 +11,12 @@ YAML::Emitter& operator << (YAML::Emitter& emitter, const Stats& s) {
 	return emitter;
 }
 
+void Stats::emit_to(IStatsSink& sink) const {
+  std::vector<std::pair<std::string, StatWrapperBase*>> stats(_registry.begin(), _registry.end());
+  std::sort(stats.begin(), stats.end());
+  for (auto [stat_name, stat_ptr] : stats) {
+    stat_ptr->emit_to(sink);
+  }
+}
+
 }        // namespace Ramulator
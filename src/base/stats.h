@@ -4,12 +4,14 @@
 #include <vector>
 #include <string>
 #include <variant>
+#include <type_traits>
 
 #include <spdlog/spdlog.h>
 #include <yaml-cpp/yaml.h>
 
 #include "base/type.h"
 #include "base/exception.h"
+#include "base/stats_sink.h"
 
 
 namespace Ramulator {
@@ -18,6 +20,14 @@ class Implementation;
 class StatWrapperBase {
   public:
     virtual void emit_to(YAML::Emitter& emitter) = 0;
+    virtual void emit_to(IStatsSink& sink) = 0;
+
+    /**
+     * @brief    The number of values of the stat that can be sampled during the simulation (0 if it is not arithmetic).
+     *
+     */
+    virtual size_t get_num_values() const = 0;
+    virtual double get_value(size_t index) const = 0;
 };
 
 template<typename T>
@@ -35,6 +45,19 @@ class Stats {
     bool is_empty() {
       return _registry.size() == 0;
     }
+
+    /**
+     * @brief    Emits all stats to sink, sorted by name so that the flat formats have the same columns in every run.
+     *
+     */
+    void emit_to(IStatsSink& sink) const;
+
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+      for (const auto& [stat_name, stat_ptr] : _registry) {
+        fn(stat_name, stat_ptr);
+      }
+    }
 };
 
 
@@ -69,6 +92,28 @@ class StatWrapper : public StatWrapperBase {
     
     StatWrapper& desc(std::string desc) { _desc = desc; return *this; };
 
+    size_t get_num_values() const override {
+      if constexpr (std::is_arithmetic_v<T>) {
+        if (std::holds_alternative<T*>(_ref)) {
+          return 1;
+        } else {
+          return std::get<std::vector<T>*>(_ref)->size();
+        }
+      }
+      return 0;
+    };
+
+    double get_value(size_t index) const override {
+      if constexpr (std::is_arithmetic_v<T>) {
+        if (std::holds_alternative<T*>(_ref)) {
+          return static_cast<double>(*std::get<T*>(_ref));
+        } else if (index < std::get<std::vector<T>*>(_ref)->size()) {
+          return static_cast<double>((*std::get<std::vector<T>*>(_ref))[index]);
+        }
+      }
+      return 0.0;
+    };
+
     void emit_to(YAML::Emitter& emitter) override {
       if        (std::holds_alternative<T*>(_ref)) {
         emitter << YAML::Key << _name;
@@ -82,13 +127,42 @@ class StatWrapper : public StatWrapperBase {
           emitter << YAML::Comment(_desc);
         }
         emitter << YAML::Value <<  YAML::BeginSeq;
-        for (const auto _val : *(std::get<std::vector<T>*>(_ref))) {
+        for (const auto& _val : *(std::get<std::vector<T>*>(_ref))) {
           emitter << _val;
         }
         emitter << YAML::EndSeq;
       }
 
     };
+
+    void emit_to(IStatsSink& sink) override {
+      if (std::holds_alternative<T*>(_ref)) {
+        emit_value(sink, _name, *(std::get<T*>(_ref)));
+      } else if (std::holds_alternative<std::vector<T>*>(_ref)) {
+        const auto& vals = *(std::get<std::vector<T>*>(_ref));
+        sink.begin_group(_name);
+        for (size_t i = 0; i < vals.size(); i++) {
+          emit_value(sink, std::to_string(i), vals[i]);
+        }
+        sink.end_group();
+      }
+    };
+
+  private:
+    static void emit_value(IStatsSink& sink, const std::string& key, const T& val) {
+      if constexpr (std::is_integral_v<T>) {
+        sink.add(key, static_cast<int64_t>(val));
+      } else if constexpr (std::is_floating_point_v<T>) {
+        sink.add(key, static_cast<double>(val));
+      } else if constexpr (requires { emit_stat(sink, key, val); }) {
+        // Structured stats (e.g., LatencyHistogram) provide their own emit_stat()
+        emit_stat(sink, key, val);
+      } else {
+        YAML::Emitter emitter;
+        emitter << val;
+        sink.add(key, std::string(emitter.c_str()));
+      }
+    };
 };
 
 }        // namespace Ramulator
@@ -0,0 +1,213 @@
+#include <vector>
+#include <variant>
+#include <fstream>
+#include <cmath>
+
+#include <spdlog/spdlog.h>
+
+#include "base/stats_sink.h"
+#include "base/exception.h"
+
+namespace Ramulator {
+
+namespace {
+
+std::ofstream open_output(const std::filesystem::path& path, bool is_binary) {
+  if (path.has_parent_path()) {
+    std::filesystem::create_directories(path.parent_path());
+  }
+  std::ofstream output(path, is_binary ? std::ios::binary : std::ios::out);
+  if (!output.is_open()) {
+    throw ConfigurationError("Cannot open stats file {}!", path.string());
+  }
+  return output;
+}
+
+
+class JSONStatsSink : public IStatsSink {
+  private:
+    fmt::memory_buffer m_buffer;
+    std::vector<bool> m_is_first = {true};    // Whether the next member of each open object is its first one
+
+  public:
+    JSONStatsSink() { m_buffer.push_back('{'); };
+
+    void begin_group(const std::string& key) override {
+      add_key(key);
+      m_buffer.push_back('{');
+      m_is_first.push_back(true);
+    };
+
+    void end_group() override {
+      m_is_first.pop_back();
+      m_buffer.push_back('}');
+    };
+
+    void add(const std::string& key, int64_t value) override {
+      add_key(key);
+      fmt::format_to(std::back_inserter(m_buffer), "{}", value);
+    };
+
+    void add(const std::string& key, double value) override {
+      add_key(key);
+      if (std::isfinite(value)) {
+        fmt::format_to(std::back_inserter(m_buffer), "{}", value);
+      } else {
+        // JSON has no NaN or infinity
+        fmt::format_to(std::back_inserter(m_buffer), "null");
+      }
+    };
+
+    void add(const std::string& key, const std::string& value) override {
+      add_key(key);
+      add_string(value);
+    };
+
+    void save(const std::filesystem::path& path) override {
+      std::ofstream output = open_output(path, false);
+      output.write(m_buffer.data(), m_buffer.size());
+      output << "}\n";
+    };
+
+  private:
+    void add_key(const std::string& key) {
+      if (!m_is_first.back()) {
+        m_buffer.push_back(',');
+      }
+      m_is_first.back() = false;
+      add_string(key);
+      m_buffer.push_back(':');
+    };
+
+    void add_string(const std::string& str) {
+      m_buffer.push_back('"');
+      for (char c : str) {
+        if (c == '"' || c == '\\') {
+          m_buffer.push_back('\\');
+          m_buffer.push_back(c);
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+          fmt::format_to(std::back_inserter(m_buffer), "\\u{:04x}", static_cast<int>(c));
+        } else {
+          m_buffer.push_back(c);
+        }
+      }
+      m_buffer.push_back('"');
+    };
+};
+
+
+/**
+ * @brief    Collects the stats as (dotted name, value) pairs for the flat formats.
+ *
+ */
+class FlatStatsSink : public IStatsSink {
+  protected:
+    using Value_t = std::variant<int64_t, double, std::string>;
+
+    std::vector<std::string> m_prefixes = {""};
+    std::vector<std::pair<std::string, Value_t>> m_entries;
+
+  public:
+    void begin_group(const std::string& key) override { m_prefixes.push_back(get_name(key) + "."); };
+    void end_group() override { m_prefixes.pop_back(); };
+
+    void add(const std::string& key, int64_t value) override { m_entries.emplace_back(get_name(key), value); };
+    void add(const std::string& key, double value) override { m_entries.emplace_back(get_name(key), value); };
+    void add(const std::string& key, const std::string& value) override { m_entries.emplace_back(get_name(key), value); };
+
+  private:
+    std::string get_name(const std::string& key) const { return m_prefixes.back() + key; };
+};
+
+
+class CSVStatsSink final : public FlatStatsSink {
+  public:
+    void save(const std::filesystem::path& path) override {
+      std::ofstream output = open_output(path, false);
+      fmt::memory_buffer buffer;
+      for (size_t i = 0; i < m_entries.size(); i++) {
+        fmt::format_to(std::back_inserter(buffer), "{}{}", i ? "," : "", quote(m_entries[i].first));
+      }
+      buffer.push_back('\n');
+      for (size_t i = 0; i < m_entries.size(); i++) {
+        if (i) {
+          buffer.push_back(',');
+        }
+        std::visit([&buffer](const auto& value) {
+          if constexpr (std::is_same_v<std::decay_t<decltype(value)>, std::string>) {
+            fmt::format_to(std::back_inserter(buffer), "{}", quote(value));
+          } else {
+            fmt::format_to(std::back_inserter(buffer), "{}", value);
+          }
+        }, m_entries[i].second);
+      }
+      buffer.push_back('\n');
+      output.write(buffer.data(), buffer.size());
+    };
+
+  private:
+    static std::string quote(const std::string& str) {
+      if (str.find_first_of(",\"\n") == std::string::npos) {
+        return str;
+      }
+      std::string quoted = "\"";
+      for (char c : str) {
+        quoted += c;
+        if (c == '"') {
+          quoted += c;
+        }
+      }
+      return quoted + "\"";
+    };
+};
+
+
+class BinaryStatsSink final : public FlatStatsSink {
+  public:
+    void save(const std::filesystem::path& path) override {
+      std::ofstream output = open_output(path, true);
+      uint32_t version = 1;
+      uint32_t num_stats = m_entries.size();
+      output.write("RAMSTATS", 8);
+      write(output, version);
+      write(output, num_stats);
+      for (const auto& [name, value] : m_entries) {
+        uint16_t name_length = name.size();
+        uint8_t type = value.index();
+        write(output, name_length);
+        output.write(name.data(), name_length);
+        write(output, type);
+        if (const auto* str = std::get_if<std::string>(&value)) {
+          uint32_t length = str->size();
+          write(output, length);
+          output.write(str->data(), length);
+        } else {
+          std::visit([&output](const auto& v) { write(output, v); }, value);
+        }
+      }
+    };
+
+  private:
+    template <typename T>
+    static void write(std::ofstream& output, const T& value) {
+      if constexpr (std::is_arithmetic_v<T>) {
+        output.write(reinterpret_cast<const char*>(&value), sizeof(value));
+      }
+    };
+};
+
+}        // namespace
+
+
+std::unique_ptr<IStatsSink> IStatsSink::create(const std::string& format) {
+  if (format == "json") {
+    return std::make_unique<JSONStatsSink>();
+  } else if (format == "csv") {
+    return std::make_unique<CSVStatsSink>();
+  } else if (format == "binary") {
+    return std::make_unique<BinaryStatsSink>();
+  }
+  throw ConfigurationError("Unrecognized stats format \"{}\" (expected json, csv, or binary)!", format);
+}
+
+}        // namespace Ramulator
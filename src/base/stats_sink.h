@@ -0,0 +1,48 @@
+#ifndef     RAMULATOR_BASE_STATS_SINK_H
+#define     RAMULATOR_BASE_STATS_SINK_H
+
+#include <string>
+#include <memory>
+#include <cstdint>
+#include <filesystem>
+
+
+namespace Ramulator {
+
+/**
+ * @brief     Receives the stats of the simulation in a machine-readable format (see Implementation::emit_stats()).
+ * @details
+ * Every component is a group named "<interface>" or "<interface>[<id>]" holding its "impl" name, its stats,
+ * and the groups of its children. Vector stats are groups keyed by the element index.
+ *
+ * The available formats are:
+ *  - json:   one nested object.
+ *  - csv:    a header row of dotted stat names (e.g., "MemorySystem.Controller[Channel 0].row_hits_0") and one row of values.
+ *  - binary: "RAMSTATS", uint32 version, uint32 number of stats, then for each stat a uint16 name length, the dotted name,
+ *            a uint8 type (0: int64, 1: double, 2: string) and the value (strings as a uint32 length and the characters).
+ *
+ */
+class IStatsSink {
+  public:
+    virtual ~IStatsSink() = default;
+
+    virtual void begin_group(const std::string& key) = 0;
+    virtual void end_group() = 0;
+
+    virtual void add(const std::string& key, int64_t value) = 0;
+    virtual void add(const std::string& key, double value) = 0;
+    virtual void add(const std::string& key, const std::string& value) = 0;
+
+    /**
+     * @brief    Writes everything added so far to path.
+     *
+     */
+    virtual void save(const std::filesystem::path& path) = 0;
+
+    static std::unique_ptr<IStatsSink> create(const std::string& format);
+};
+
+}        // namespace Ramulator
+
+
+#endif   // RAMULATOR_BASE_STATS_SINK_H
@@ -6,12 +6,14 @@
 #include <string>
 #include <type_traits>
 
+#include "base/inline_vector.h"
+
 
 namespace Ramulator {
 
-using Clk_t     = int64_t;            // Clock cycle
-using Addr_t    = int64_t;            // Plain address as seen by the OS
-using AddrVec_t = std::vector<int>;   // Device address vector as is sent to the device from the controller
+using Clk_t     = int64_t;                // Clock cycle
+using Addr_t    = int64_t;                // Plain address as seen by the OS
+using AddrVec_t = InlineVector<int, 6>;   // Device address vector as is sent to the device from the controller (inline, up to 6 levels)
 
 template<typename T>
 using Registry_t = std::unordered_map<std::string, T>;
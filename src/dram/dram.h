@@ -4,11 +4,13 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <mutex>
 #include <functional>
 
 #include "base/base.h"
 #include "dram/spec.h"
 #include "dram/node.h"
+#include "dram/future_action.h"
 
 namespace Ramulator {
 
@@ -36,8 +38,8 @@ class IDRAM : public Clocked<IDRAM> {
     SpecDef m_requests;                                     // The definition of all requests supported
     SpecLUT<Command_t> m_request_translations{m_requests};  // A LUT of the final DRAM commands needed by every request
 
-    // TODO: make this a priority queue
-    std::vector<FutureAction> m_future_actions;  // A vector of requests that requires future state changes
+    FutureActionQueue m_future_actions;          // The requests that require future state changes, bucketed by cycle
+    std::mutex m_future_actions_mutex;           // Guards m_future_actions when channels are ticked in parallel
 
   /************************************************
    *                Node States
@@ -46,6 +48,8 @@ class IDRAM : public Clocked<IDRAM> {
     SpecDef m_states;
     SpecLUT<State_t> m_init_states{m_states};
 
+    std::vector<uint64_t> m_state_epochs;   // Per channel, counts the state updates (by issued commands and future actions)
+
 
   /************************************************
    *                   Timing
@@ -108,6 +112,17 @@ class IDRAM : public Clocked<IDRAM> {
      */
     virtual bool check_ready(int command, const AddrVec_t& addr_vec) = 0;
 
+    /**
+     * @brief     Returns the earliest clock cycle at which the device can accept the given command.
+     * @details
+     * Given a command and its address, this function should return the earliest cycle allowed by the timing 
+     * constraints of all nodes on the path to the command's scope, assuming that no other command is issued 
+     * before. The command is ready iff the returned cycle is not later than the current clock cycle 
+     * (i.e., check_ready() is equivalent to get_ready_clk() <= get_clk()).
+     * 
+     */
+    virtual Clk_t get_ready_clk(int command, const AddrVec_t& addr_vec) = 0;
+
     /**
      * @brief     Checks whether the command will result in a rowbuffer hit
      * @details
@@ -138,6 +153,45 @@ class IDRAM : public Clocked<IDRAM> {
     */
     virtual void finalize() {};
 
+    /**
+     * @brief     Schedules a future state change (e.g., the end of a refresh).
+     * @details
+     * Controllers of different channels may issue commands concurrently (see GenericDRAMSystem), 
+     * so all future actions must be added through this function.
+     *
+     */
+    void add_future_action(const FutureAction& future_action) {
+      std::lock_guard<std::mutex> lock(m_future_actions_mutex);
+      m_future_actions.push(future_action, m_clk);
+    };
+
+    /**
+     * @brief     Returns the cycle of the earliest pending future action (e.g., the end of a refresh).
+     *
+     */
+    virtual Clk_t get_next_event_cycle() override { return m_future_actions.get_next_deadline(m_clk); };
+
+    /**
+     * @brief     Advances the device clock. Only valid up to (but not including) get_next_event_cycle().
+     *
+     */
+    virtual void fast_forward(Clk_t num_cycles) override { m_clk += num_cycles; };
+
+    /**
+     * @brief     Returns the state epoch of a channel.
+     * @details
+     * The epoch changes whenever the states of the nodes in the channel (may) change, so that users can 
+     * cache anything derived from the device states (e.g., prerequisite commands) until the epoch changes.
+     *
+     */
+    uint64_t get_state_epoch(int channel_id) const { return m_state_epochs[channel_id]; };
+
+    /**
+     * @brief     Returns the current clock cycle of the device.
+     *
+     */
+    Clk_t get_clk() const { return m_clk; };
+
   /************************************************
    *        Interface to Query Device Spec
    ***********************************************/   
@@ -153,6 +207,7 @@ class IDRAM : public Clocked<IDRAM> {
 };
 
 #define RAMULATOR_DECLARE_SPECS() \
+  static_assert(m_levels.size() <= AddrVec_t::capacity(), "The organization hierarchy is too deep for AddrVec_t!"); \
   IDRAM::m_internal_prefetch_size = m_internal_prefetch_size; \
   IDRAM::m_levels = m_levels; \
   IDRAM::m_commands = m_commands; \
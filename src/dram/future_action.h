@@ -0,0 +1,127 @@
+#ifndef RAMULATOR_DRAM_FUTURE_ACTION_H
+#define RAMULATOR_DRAM_FUTURE_ACTION_H
+
+#include <vector>
+#include <bit>
+#include <algorithm>
+#include <cstdint>
+
+#include "base/type.h"
+#include "base/clocked.h"
+#include "dram/spec.h"
+
+namespace Ramulator {
+
+/**
+ * @brief     A timing wheel of future actions (e.g., the ends of refreshes), bucketed by their cycle.
+ * @details
+ * The wheel always spans more cycles than the furthest pending action, so each bucket only holds the
+ * actions of a single cycle: firing the actions of a cycle does not look at any other action. A bitmap
+ * of the non-empty buckets lets the next deadline be found a word (64 cycles) at a time.
+ *
+ */
+class FutureActionQueue {
+  private:
+    std::vector<std::vector<FutureAction>> m_buckets;  // The actions of cycle clk are in m_buckets[clk & m_mask]
+    std::vector<uint64_t> m_occupied;                  // Bitmap of the non-empty buckets
+    size_t m_mask = 0;
+    size_t m_size = 0;
+
+    std::vector<FutureAction> m_firing;                // The bucket being fired (so that handlers can add new actions)
+
+  public:
+    FutureActionQueue(size_t num_buckets = 1024) { resize(num_buckets); };
+
+    size_t size() const { return m_size; };
+    bool empty() const { return m_size == 0; };
+
+    /**
+     * @brief     Adds an action at future_action.clk. Actions that are not in the future (of clk) never fire.
+     *
+     */
+    void push(const FutureAction& future_action, Clk_t clk) {
+      if (future_action.clk <= clk) {
+        return;
+      }
+      if (static_cast<size_t>(future_action.clk - clk) >= m_buckets.size()) {
+        resize(std::bit_ceil(static_cast<size_t>(future_action.clk - clk) + 1));
+      }
+
+      size_t slot = future_action.clk & m_mask;
+      m_buckets[slot].push_back(future_action);
+      m_occupied[slot / 64] |= uint64_t(1) << (slot % 64);
+      m_size++;
+    };
+
+    /**
+     * @brief     Calls handler on every action at cycle clk (latest added first) and removes them.
+     * @details   Actions that are not due at clk yet (i.e., one or more turns of the wheel later) are never fired early.
+     *
+     */
+    template<typename F>
+    void pop(Clk_t clk, F&& handler) {
+      size_t slot = clk & m_mask;
+      if (!(m_occupied[slot / 64] & (uint64_t(1) << (slot % 64)))) {
+        return;
+      }
+      // All actions of a bucket are at the same cycle
+      if (m_buckets[slot].front().clk > clk) {
+        return;
+      }
+
+      m_firing.swap(m_buckets[slot]);
+      m_occupied[slot / 64] &= ~(uint64_t(1) << (slot % 64));
+      m_size -= m_firing.size();
+      for (int i = m_firing.size() - 1; i >= 0; i--) {
+        handler(m_firing[i]);
+      }
+      m_firing.clear();
+    };
+
+    /**
+     * @brief     Returns the earliest cycle after clk with a pending action, or NEVER_CLK.
+     *
+     */
+    Clk_t get_next_deadline(Clk_t clk) const {
+      if (m_size == 0) {
+        return NEVER_CLK;
+      }
+
+      size_t num_buckets = m_buckets.size();
+      size_t offset = 1;
+      while (offset < num_buckets) {
+        size_t slot = (clk + offset) & m_mask;
+        uint64_t bits = m_occupied[slot / 64] >> (slot % 64);
+        if (bits) {
+          offset += std::countr_zero(bits);
+          return offset < num_buckets ? clk + offset : NEVER_CLK;
+        }
+        offset += 64 - slot % 64;
+      }
+      return NEVER_CLK;
+    };
+
+  private:
+    void resize(size_t num_buckets) {
+      num_buckets = std::max<size_t>(std::bit_ceil(num_buckets), 64);
+
+      std::vector<std::vector<FutureAction>> buckets(num_buckets);
+      m_buckets.swap(buckets);
+      m_occupied.assign(num_buckets / 64, 0);
+      m_mask = num_buckets - 1;
+      m_size = 0;
+
+      for (auto& bucket : buckets) {
+        for (const auto& future_action : bucket) {
+          size_t slot = future_action.clk & m_mask;
+          m_buckets[slot].push_back(future_action);
+          m_occupied[slot / 64] |= uint64_t(1) << (slot % 64);
+          m_size++;
+        }
+      }
+    };
+};
+
+}        // namespace Ramulator
+
+#endif   // RAMULATOR_DRAM_FUTURE_ACTION_H
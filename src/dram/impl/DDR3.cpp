@@ -133,11 +133,6 @@ class DDR3 : public IDRAM, public Implementation {
       Node(DDR3* dram, Node* parent, int level, int id) : DRAMNodeBase<DDR3>(dram, parent, level, id) {};
     };
     std::vector<Node*> m_channels;
-    
-    FuncMatrix<ActionFunc_t<Node>>  m_actions;
-    FuncMatrix<PreqFunc_t<Node>>    m_preqs;
-    FuncMatrix<RowhitFunc_t<Node>>  m_rowhits;
-    FuncMatrix<RowopenFunc_t<Node>> m_rowopens;
 
 
   public:
@@ -150,11 +145,6 @@ class DDR3 : public IDRAM, public Implementation {
       set_organization();
       set_timing_vals();
 
-      set_actions();
-      set_preqs();
-      set_rowhits();
-      set_rowopens();
-      
       create_nodes();
     };
 
@@ -174,6 +164,11 @@ class DDR3 : public IDRAM, public Implementation {
       return m_channels[channel_id]->check_ready(command, addr_vec, m_clk);
     };
 
+    Clk_t get_ready_clk(int command, const AddrVec_t& addr_vec) override {
+      int channel_id = addr_vec[m_levels["channel"]];
+      return m_channels[channel_id]->get_ready_clk(command, addr_vec);
+    };
+
     bool check_rowbuffer_hit(int command, const AddrVec_t& addr_vec) override {
       int channel_id = addr_vec[m_levels["channel"]];
       return m_channels[channel_id]->check_rowbuffer_hit(command, addr_vec, m_clk);
@@ -394,8 +389,9 @@ class DDR3 : public IDRAM, public Implementation {
 
     };
 
-    void set_actions() {
-      m_actions.resize(m_levels.size(), std::vector<ActionFunc_t<Node>>(m_commands.size()));
+  public:
+    inline static constexpr FuncMatrix<ActionFunc_t<Node>, DDR3> m_actions = [] {
+      FuncMatrix<ActionFunc_t<Node>, DDR3> m_actions {};
 
       // Rank Actions
       m_actions[m_levels["rank"]][m_commands["PREA"]] = Lambdas::Action::Rank::PREab<DDR3>;
@@ -405,10 +401,12 @@ class DDR3 : public IDRAM, public Implementation {
       m_actions[m_levels["bank"]][m_commands["PRE"]] = Lambdas::Action::Bank::PRE<DDR3>;
       m_actions[m_levels["bank"]][m_commands["RDA"]] = Lambdas::Action::Bank::PRE<DDR3>;
       m_actions[m_levels["bank"]][m_commands["WRA"]] = Lambdas::Action::Bank::PRE<DDR3>;
-    };
 
-    void set_preqs() {
-      m_preqs.resize(m_levels.size(), std::vector<PreqFunc_t<Node>>(m_commands.size()));
+      return m_actions;
+    }();
+
+    inline static constexpr FuncMatrix<PreqFunc_t<Node>, DDR3> m_preqs = [] {
+      FuncMatrix<PreqFunc_t<Node>, DDR3> m_preqs {};
 
       // Rank Actions
       m_preqs[m_levels["rank"]][m_commands["REFab"]] = Lambdas::Preq::Rank::RequireAllBanksClosed<DDR3>;
@@ -416,23 +414,30 @@ class DDR3 : public IDRAM, public Implementation {
       // Bank actions
       m_preqs[m_levels["bank"]][m_commands["RD"]] = Lambdas::Preq::Bank::RequireRowOpen<DDR3>;
       m_preqs[m_levels["bank"]][m_commands["WR"]] = Lambdas::Preq::Bank::RequireRowOpen<DDR3>;
-    };
 
-    void set_rowhits() {
-      m_rowhits.resize(m_levels.size(), std::vector<RowhitFunc_t<Node>>(m_commands.size()));
+      return m_preqs;
+    }();
+
+    inline static constexpr FuncMatrix<RowhitFunc_t<Node>, DDR3> m_rowhits = [] {
+      FuncMatrix<RowhitFunc_t<Node>, DDR3> m_rowhits {};
 
       m_rowhits[m_levels["bank"]][m_commands["RD"]] = Lambdas::RowHit::Bank::RDWR<DDR3>;
       m_rowhits[m_levels["bank"]][m_commands["WR"]] = Lambdas::RowHit::Bank::RDWR<DDR3>;
-    }
 
+      return m_rowhits;
+    }();
 
-    void set_rowopens() {
-      m_rowopens.resize(m_levels.size(), std::vector<RowhitFunc_t<Node>>(m_commands.size()));
+
+    inline static constexpr FuncMatrix<RowopenFunc_t<Node>, DDR3> m_rowopens = [] {
+      FuncMatrix<RowopenFunc_t<Node>, DDR3> m_rowopens {};
 
       m_rowopens[m_levels["bank"]][m_commands["RD"]] = Lambdas::RowOpen::Bank::RDWR<DDR3>;
       m_rowopens[m_levels["bank"]][m_commands["WR"]] = Lambdas::RowOpen::Bank::RDWR<DDR3>;
-    }
 
+      return m_rowopens;
+    }();
+
+  private:
 
     void create_nodes() {
       int num_channels = m_organization.count[m_levels["channel"]];
@@ -189,11 +189,6 @@ class DDR4RVRR : public IDRAM, public Implementation {
     };
     std::vector<Node*> m_channels;
     
-    FuncMatrix<ActionFunc_t<Node>>  m_actions;
-    FuncMatrix<PreqFunc_t<Node>>    m_preqs;
-    FuncMatrix<RowhitFunc_t<Node>>  m_rowhits;
-    FuncMatrix<RowopenFunc_t<Node>> m_rowopens;
-    FuncMatrix<PowerFunc_t<Node>>   m_powers;
     float m_latency_factor_vrr = 1.0f;
     float m_latency_factor_rfc = 1.0f;
 
@@ -208,13 +203,9 @@ class DDR4RVRR : public IDRAM, public Implementation {
       m_clk++;
 
       // Check if there is any future action at this cycle
-      for (int i = m_future_actions.size() - 1; i >= 0; i--) {
-        auto& future_action = m_future_actions[i];
-        if (future_action.clk == m_clk) {
-          handle_future_action(future_action.cmd, future_action.addr_vec);
-          m_future_actions.erase(m_future_actions.begin() + i);
-        }
-      }
+      m_future_actions.pop(m_clk, [this] (const FutureAction& future_action) {
+        handle_future_action(future_action.cmd, future_action.addr_vec);
+      });
     };
 
     void init() override {
@@ -224,10 +215,6 @@ class DDR4RVRR : public IDRAM, public Implementation {
       set_organization();
       set_timing_vals();
 
-      set_actions();
-      set_preqs();
-      set_rowhits();
-      set_rowopens();
       set_powers();
       
       create_nodes();
@@ -247,15 +234,15 @@ class DDR4RVRR : public IDRAM, public Implementation {
       switch (command) {
         case m_commands("REFab"):
           // REFab command requires future action after nRFC cycles
-          m_future_actions.push_back({command, addr_vec, m_clk + m_timing_vals("nRFC") - 1});
+          add_future_action({command, addr_vec, m_clk + m_timing_vals("nRFC") - 1});
           break;
         case m_commands("VRR"):
           // Check if there is any bank that is not in the closed state
-          m_future_actions.push_back({command, addr_vec, m_clk + m_timing_vals("nVRR") - 1});
+          add_future_action({command, addr_vec, m_clk + m_timing_vals("nVRR") - 1});
           break;
         case m_commands("RVRR"):
           // Check if there is any bank that is not in the closed state
-          m_future_actions.push_back({command, addr_vec, m_clk + m_timing_vals("nRVRR") - 1});
+          add_future_action({command, addr_vec, m_clk + m_timing_vals("nRVRR") - 1});
           break;
         default:
           // Other commands do not require future actions
@@ -294,6 +281,11 @@ class DDR4RVRR : public IDRAM, public Implementation {
       return m_channels[channel_id]->check_ready(command, addr_vec, m_clk);
     };
 
+    Clk_t get_ready_clk(int command, const AddrVec_t& addr_vec) override {
+      int channel_id = addr_vec[m_levels["channel"]];
+      return m_channels[channel_id]->get_ready_clk(command, addr_vec);
+    };
+
     bool check_rowbuffer_hit(int command, const AddrVec_t& addr_vec) override {
       int channel_id = addr_vec[m_levels["channel"]];
       return m_channels[channel_id]->check_rowbuffer_hit(command, addr_vec, m_clk);
@@ -573,8 +565,9 @@ class DDR4RVRR : public IDRAM, public Implementation {
 
     };
 
-    void set_actions() {
-      m_actions.resize(m_levels.size(), std::vector<ActionFunc_t<Node>>(m_commands.size()));
+  public:
+    inline static constexpr FuncMatrix<ActionFunc_t<Node>, DDR4RVRR> m_actions = [] {
+      FuncMatrix<ActionFunc_t<Node>, DDR4RVRR> m_actions {};
 
       // Rank Actions
       m_actions[m_levels["rank"]][m_commands["PREA"]] = Lambdas::Action::Rank::PREab<DDR4RVRR>;
@@ -590,10 +583,12 @@ class DDR4RVRR : public IDRAM, public Implementation {
       m_actions[m_levels["bank"]][m_commands["VRR_end"]] = Lambdas::Action::Bank::VRR_end<DDR4RVRR>;
       m_actions[m_levels["bank"]][m_commands["RVRR"]] = Lambdas::Action::Bank::VRR<DDR4RVRR>;
       m_actions[m_levels["bank"]][m_commands["RVRR_end"]] = Lambdas::Action::Bank::VRR_end<DDR4RVRR>;
-    };
 
-    void set_preqs() {
-      m_preqs.resize(m_levels.size(), std::vector<PreqFunc_t<Node>>(m_commands.size()));
+      return m_actions;
+    }();
+
+    inline static constexpr FuncMatrix<PreqFunc_t<Node>, DDR4RVRR> m_preqs = [] {
+      FuncMatrix<PreqFunc_t<Node>, DDR4RVRR> m_preqs {};
 
       // Rank Actions
       m_preqs[m_levels["rank"]][m_commands["REFab"]] = Lambdas::Preq::Rank::RequireAllBanksClosed<DDR4RVRR>;
@@ -606,23 +601,55 @@ class DDR4RVRR : public IDRAM, public Implementation {
       m_preqs[m_levels["bank"]][m_commands["RVRR"]] = Lambdas::Preq::Bank::RequireBankClosed<DDR4RVRR>;
       m_preqs[m_levels["bank"]][m_commands["ACT"]] = Lambdas::Preq::Bank::RequireRowOpen<DDR4RVRR>;
       m_preqs[m_levels["bank"]][m_commands["PRE"]] = Lambdas::Preq::Bank::RequireBankClosed<DDR4RVRR>;
-      };
 
-    void set_rowhits() {
-      m_rowhits.resize(m_levels.size(), std::vector<RowhitFunc_t<Node>>(m_commands.size()));
+      return m_preqs;
+    }();
+
+    inline static constexpr FuncMatrix<RowhitFunc_t<Node>, DDR4RVRR> m_rowhits = [] {
+      FuncMatrix<RowhitFunc_t<Node>, DDR4RVRR> m_rowhits {};
 
       m_rowhits[m_levels["bank"]][m_commands["RD"]] = Lambdas::RowHit::Bank::RDWR<DDR4RVRR>;
       m_rowhits[m_levels["bank"]][m_commands["WR"]] = Lambdas::RowHit::Bank::RDWR<DDR4RVRR>;
-    }
+
+      return m_rowhits;
+    }();
 
 
-    void set_rowopens() {
-      m_rowopens.resize(m_levels.size(), std::vector<RowhitFunc_t<Node>>(m_commands.size()));
+    inline static constexpr FuncMatrix<RowopenFunc_t<Node>, DDR4RVRR> m_rowopens = [] {
+      FuncMatrix<RowopenFunc_t<Node>, DDR4RVRR> m_rowopens {};
 
       m_rowopens[m_levels["bank"]][m_commands["RD"]] = Lambdas::RowOpen::Bank::RDWR<DDR4RVRR>;
       m_rowopens[m_levels["bank"]][m_commands["WR"]] = Lambdas::RowOpen::Bank::RDWR<DDR4RVRR>;
-    }
 
+      return m_rowopens;
+    }();
+
+    inline static constexpr FuncMatrix<PowerFunc_t<Node>, DDR4RVRR> m_powers = [] {
+      FuncMatrix<PowerFunc_t<Node>, DDR4RVRR> m_powers {};
+
+      m_powers[m_levels["bank"]][m_commands["ACT"]] = Lambdas::Power::Bank::ACT<DDR4RVRR>;
+      m_powers[m_levels["bank"]][m_commands["PRE"]] = Lambdas::Power::Bank::PRE<DDR4RVRR>;
+      m_powers[m_levels["bank"]][m_commands["RD"]]  = Lambdas::Power::Bank::RD<DDR4RVRR>;
+      m_powers[m_levels["bank"]][m_commands["WR"]]  = Lambdas::Power::Bank::WR<DDR4RVRR>;
+      m_powers[m_levels["bank"]][m_commands["RDA"]] = Lambdas::Power::Bank::AutoPRE<DDR4RVRR>;
+      m_powers[m_levels["bank"]][m_commands["WRA"]] = Lambdas::Power::Bank::AutoPRE<DDR4RVRR>;
+      m_powers[m_levels["bank"]][m_commands["VRR"]]  = Lambdas::Power::Bank::VRR<DDR4RVRR>;
+      m_powers[m_levels["bank"]][m_commands["RVRR"]]  = Lambdas::Power::Bank::RVRR<DDR4RVRR>;
+
+      m_powers[m_levels["rank"]][m_commands["ACT"]] = Lambdas::Power::Rank::ACT<DDR4RVRR>;
+      m_powers[m_levels["rank"]][m_commands["PRE"]] = Lambdas::Power::Rank::PRE<DDR4RVRR>;
+      m_powers[m_levels["rank"]][m_commands["PREA"]] = Lambdas::Power::Rank::PREA<DDR4RVRR>;
+      m_powers[m_levels["rank"]][m_commands["REFab"]] = Lambdas::Power::Rank::REFab<DDR4RVRR>;
+      m_powers[m_levels["rank"]][m_commands["REFab_end"]] = Lambdas::Power::Rank::REFab_end<DDR4RVRR>;
+      m_powers[m_levels["rank"]][m_commands["VRR"]] = Lambdas::Power::Rank::VRR<DDR4RVRR>;
+      m_powers[m_levels["rank"]][m_commands["VRR_end"]] = Lambdas::Power::Rank::VRR_end<DDR4RVRR>;
+      m_powers[m_levels["rank"]][m_commands["RVRR"]] = Lambdas::Power::Rank::VRR<DDR4RVRR>;
+      m_powers[m_levels["rank"]][m_commands["RVRR_end"]] = Lambdas::Power::Rank::VRR_end<DDR4RVRR>;
+
+      return m_powers;
+    }();
+
+  private:
     void set_powers() {
 
       m_drampower_enable = param<bool>("drampower_enable").default_val(false);
@@ -663,25 +690,6 @@ class DDR4RVRR : public IDRAM, public Implementation {
         }
       }
 
-      m_powers.resize(m_levels.size(), std::vector<PowerFunc_t<Node>>(m_commands.size()));
-
-      m_powers[m_levels["bank"]][m_commands["ACT"]] = Lambdas::Power::Bank::ACT<DDR4RVRR>;
-      m_powers[m_levels["bank"]][m_commands["PRE"]] = Lambdas::Power::Bank::PRE<DDR4RVRR>;
-      m_powers[m_levels["bank"]][m_commands["RD"]]  = Lambdas::Power::Bank::RD<DDR4RVRR>;
-      m_powers[m_levels["bank"]][m_commands["WR"]]  = Lambdas::Power::Bank::WR<DDR4RVRR>;
-      m_powers[m_levels["bank"]][m_commands["VRR"]]  = Lambdas::Power::Bank::VRR<DDR4RVRR>;
-      m_powers[m_levels["bank"]][m_commands["RVRR"]]  = Lambdas::Power::Bank::RVRR<DDR4RVRR>;
-
-      m_powers[m_levels["rank"]][m_commands["ACT"]] = Lambdas::Power::Rank::ACT<DDR4RVRR>;
-      m_powers[m_levels["rank"]][m_commands["PRE"]] = Lambdas::Power::Rank::PRE<DDR4RVRR>;
-      m_powers[m_levels["rank"]][m_commands["PREA"]] = Lambdas::Power::Rank::PREA<DDR4RVRR>;
-      m_powers[m_levels["rank"]][m_commands["REFab"]] = Lambdas::Power::Rank::REFab<DDR4RVRR>;
-      m_powers[m_levels["rank"]][m_commands["REFab_end"]] = Lambdas::Power::Rank::REFab_end<DDR4RVRR>;
-      m_powers[m_levels["rank"]][m_commands["VRR"]] = Lambdas::Power::Rank::VRR<DDR4RVRR>;
-      m_powers[m_levels["rank"]][m_commands["VRR_end"]] = Lambdas::Power::Rank::VRR_end<DDR4RVRR>;
-      m_powers[m_levels["rank"]][m_commands["RVRR"]] = Lambdas::Power::Rank::VRR<DDR4RVRR>;
-      m_powers[m_levels["rank"]][m_commands["RVRR_end"]] = Lambdas::Power::Rank::VRR_end<DDR4RVRR>;
-
       // register stats
       register_stat(s_total_background_energy).name("total_background_energy");
       register_stat(s_total_cmd_energy).name("total_cmd_energy");
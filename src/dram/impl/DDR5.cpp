@@ -1,5 +1,6 @@
 #include "dram/dram.h"
 #include "dram/lambdas.h"
+#include "dram/power_trace.h"
 
 namespace Ramulator {
 
@@ -27,11 +28,11 @@ class DDR5 : public IDRAM, public Implementation {
     };
 
     inline static const std::map<std::string, std::vector<int>> timing_presets = {
-      //   name         rate   nBL  nCL nRCD   nRP  nRAS   nRC   nWR  nRTP nCWL nPPD nCCDS nCCDS_WR nCCDS_WTR nCCDL nCCDL_WR nCCDL_WTR nRRDS nRRDL nFAW nRFC1 nRFC2 nRFCsb nREFI nREFSBRD nRFM1 nRFM2 nRFMsb nDRFMab nDRFMsb nCS, tCK_ps
-      {"DDR5_3200AN",  {3200,   8,  24,  24,   24,   52,   75,   48,   12,  22,  2,    8,     8,     22+8+4,    8,     16,    22+8+16,   8,   -1,   -1,  -1,   -1,   -1,    -1,     48,    -1,   -1,   -1,     -1,     -1,    2,   625}},
-      {"DDR5_3200BN",  {3200,   8,  26,  26,   26,   52,   77,   48,   12,  24,  2,    8,     8,     24+8+4,    8,     16,    24+8+16,   8,   -1,   -1,  -1,   -1,   -1,    -1,     48,    -1,   -1,   -1,     -1,     -1,    2,   625}},
-      {"DDR5_3200C",   {3200,   8,  28,  28,   28,   52,   79,   48,   12,  26,  2,    8,     8,     26+8+4,    8,     16,    26+8+16,   8,   -1,   -1,  -1,   -1,   -1,    -1,     48,    -1,   -1,   -1,     -1,     -1,    2,   625}},
-      {"DDR5_4800AN",  {4800,   8,  34,  34,   34,   77,   111,  72,   18,  32,  2,    8,     8,     32+8+6,    12,    48,    32+8+24,   8,   -1,   -1,  -1,   -1,   -1,    -1,     73,    -1,   -1,   -1,     -1,     -1,    2,   416}},
+      //   name         rate   nBL  nCL nRCD   nRP  nRAS   nRC   nWR  nRTP nCWL nPPD nCCDS nCCDS_WR nCCDS_WTR nCCDL nCCDL_WR nCCDL_WTR nRRDS nRRDL nFAW nRFC1 nRFC2 nRFCsb nREFI nREFSBRD nRFM1 nRFM2 nRFMsb nDRFMab nDRFMsb nCS   nPD   nXP   nCSL  nXS,  tCK_ps
+      {"DDR5_3200AN",  {3200,   8,  24,  24,   24,   52,   75,   48,   12,  22,  2,    8,     8,     22+8+4,    8,     16,    22+8+16,   8,   -1,   -1,  -1,   -1,   -1,    -1,     48,    -1,   -1,   -1,     -1,     -1,    2,    -1,   -1,   -1,   -1,   625}},
+      {"DDR5_3200BN",  {3200,   8,  26,  26,   26,   52,   77,   48,   12,  24,  2,    8,     8,     24+8+4,    8,     16,    24+8+16,   8,   -1,   -1,  -1,   -1,   -1,    -1,     48,    -1,   -1,   -1,     -1,     -1,    2,    -1,   -1,   -1,   -1,   625}},
+      {"DDR5_3200C",   {3200,   8,  28,  28,   28,   52,   79,   48,   12,  26,  2,    8,     8,     26+8+4,    8,     16,    26+8+16,   8,   -1,   -1,  -1,   -1,   -1,    -1,     48,    -1,   -1,   -1,     -1,     -1,    2,    -1,   -1,   -1,   -1,   625}},
+      {"DDR5_4800AN",  {4800,   8,  34,  34,   34,   77,   111,  72,   18,  32,  2,    8,     8,     32+8+6,    12,    48,    32+8+24,   8,   -1,   -1,  -1,   -1,   -1,    -1,     73,    -1,   -1,   -1,     -1,     -1,    2,    -1,   -1,   -1,   -1,   416}},
     };
 
     inline static const std::map<std::string, std::vector<double>> voltage_presets = {
@@ -40,8 +41,8 @@ class DDR5 : public IDRAM, public Implementation {
     };
 
     inline static const std::map<std::string, std::vector<double>> current_presets = {
-      // name           IDD0  IDD2N   IDD3N   IDD4R   IDD4W   IDD5B   IPP0  IPP2N  IPP3N  IPP4R  IPP4W  IPP5B
-      {"Default",       {60,   50,     55,     145,    145,    362,     3,    3,     3,     3,     3,     48}},
+      // name           IDD0  IDD2N   IDD3N   IDD4R   IDD4W   IDD5B   IDD2P   IDD3P   IDD6N   IPP0  IPP2N  IPP3N  IPP4R  IPP4W  IPP5B  IPP2P  IPP3P  IPP6N
+      {"Default",       {60,   50,     55,     145,    145,    362,    40,     47,     34,      3,    3,     3,     3,     3,     48,    3,     3,     4}},
     };
   /************************************************
    *                Organization
@@ -63,6 +64,7 @@ class DDR5 : public IDRAM, public Implementation {
       "REFab",  "REFsb", "REFab_end", "REFsb_end",
       "RFMab",  "RFMsb", "RFMab_end", "RFMsb_end",
       "DRFMab", "DRFMsb", "DRFMab_end", "DRFMsb_end",
+      "PDE", "PDX", "SRE", "SRX",
     };
 
     inline static const ImplLUT m_command_scopes = LUT (
@@ -73,6 +75,7 @@ class DDR5 : public IDRAM, public Implementation {
         {"REFab",  "rank"},  {"REFsb",  "bank"}, {"REFab_end",  "rank"},  {"REFsb_end",  "bank"},
         {"RFMab",  "rank"},  {"RFMsb",  "bank"}, {"RFMab_end",  "rank"},  {"RFMsb_end",  "bank"},
         {"DRFMab", "rank"},  {"DRFMsb", "bank"}, {"DRFMab_end", "rank"},  {"DRFMsb_end", "bank"},
+        {"PDE",    "rank"},  {"PDX",    "rank"}, {"SRE",        "rank"},  {"SRX",        "rank"},
       }
     );
 
@@ -99,6 +102,10 @@ class DDR5 : public IDRAM, public Implementation {
         {"DRFMsb",      {false,  false,   false,   true }},
         {"DRFMab_end",  {false,  true,    false,   false}},
         {"DRFMsb_end",  {false,  true,    false,   false}},
+        {"PDE",         {false,  false,   false,   false}},
+        {"PDX",         {false,  false,   false,   false}},
+        {"SRE",         {false,  false,   false,   false}},
+        {"SRX",         {false,  false,   false,   false}},
       }
     );
 
@@ -107,7 +114,8 @@ class DDR5 : public IDRAM, public Implementation {
       "all-bank-refresh", "same-bank-refresh", 
       "rfm", "same-bank-rfm",
       "directed-rfm", "same-bank-directed-rfm",
-      "open-row", "close-row"
+      "open-row", "close-row",
+      "power-down", "self-refresh"
     };
 
     inline static const ImplLUT m_request_translations = LUT (
@@ -116,7 +124,8 @@ class DDR5 : public IDRAM, public Implementation {
         {"all-bank-refresh", "REFab"}, {"same-bank-refresh", "REFsb"}, 
         {"rfm", "RFMab"}, {"same-bank-rfm", "RFMsb"}, 
         {"directed-rfm", "DRFMab"}, {"same-bank-directed-rfm", "DRFMsb"}, 
-        {"open-row", "ACT"}, {"close-row", "PRE"}
+        {"open-row", "ACT"}, {"close-row", "PRE"},
+        {"power-down", "PDE"}, {"self-refresh", "SRE"}
       }
     );
 
@@ -135,6 +144,7 @@ class DDR5 : public IDRAM, public Implementation {
       "nRFM1", "nRFM2", "nRFMsb", 
       "nDRFMab", "nDRFMsb", 
       "nCS",
+      "nPD", "nXP", "nCSL", "nXS",
       "tCK_ps"
     };
    
@@ -146,8 +156,8 @@ class DDR5 : public IDRAM, public Implementation {
     };
     
     inline static constexpr ImplDef m_currents = {
-      "IDD0", "IDD2N", "IDD3N", "IDD4R", "IDD4W", "IDD5B",
-      "IPP0", "IPP2N", "IPP3N", "IPP4R", "IPP4W", "IPP5B"
+      "IDD0", "IDD2N", "IDD3N", "IDD4R", "IDD4W", "IDD5B", "IDD2P", "IDD3P", "IDD6N",
+      "IPP0", "IPP2N", "IPP3N", "IPP4R", "IPP4W", "IPP5B", "IPP2P", "IPP3P", "IPP6N"
     };
 
     inline static constexpr ImplDef m_cmds_counted = {
@@ -158,7 +168,7 @@ class DDR5 : public IDRAM, public Implementation {
    *                 Node States
    ***********************************************/
     inline static constexpr ImplDef m_states = {
-       "Opened", "Closed", "PowerUp", "N/A", "Refreshing"
+       "Opened", "Closed", "PowerUp", "N/A", "Refreshing", "PowerDown", "SelfRefresh"
     };
 
     inline static const ImplLUT m_init_states = LUT (
@@ -177,17 +187,17 @@ class DDR5 : public IDRAM, public Implementation {
       Node(DDR5* dram, Node* parent, int level, int id) : DRAMNodeBase<DDR5>(dram, parent, level, id) {};
     };
     std::vector<Node*> m_channels;
-    
-    FuncMatrix<ActionFunc_t<Node>>  m_actions;
-    FuncMatrix<PreqFunc_t<Node>>    m_preqs;
-    FuncMatrix<RowhitFunc_t<Node>>  m_rowhits;
-    FuncMatrix<RowopenFunc_t<Node>> m_rowopens;
-    FuncMatrix<PowerFunc_t<Node>>   m_powers;
 
     double s_total_rfm_energy = 0.0;
+    double s_total_powerdown_energy_saved = 0.0;
 
     std::vector<size_t> s_total_rfm_cycles;
 
+    Clk_t m_power_trace_interval = 0;                           // Sample the energy of the ranks every this many cycles (0 to disable)
+    Clk_t m_next_power_sample_clk = -1;
+    PowerTrace m_power_trace;
+    std::vector<PowerStats::Residency> m_sampled_residencies;   // The residency of each rank at the last sample
+
   /************************************************
    *                 RFM Related
    ***********************************************/
@@ -200,24 +210,29 @@ class DDR5 : public IDRAM, public Implementation {
       m_clk++;
 
       // Check if there is any future action at this cycle
-      for (int i = m_future_actions.size() - 1; i >= 0; i--) {
-        auto& future_action = m_future_actions[i];
-        if (future_action.clk == m_clk) {
-          handle_future_action(future_action.cmd, future_action.addr_vec);
-          m_future_actions.erase(m_future_actions.begin() + i);
-        }
+      m_future_actions.pop(m_clk, [this] (const FutureAction& future_action) {
+        handle_future_action(future_action.cmd, future_action.addr_vec);
+      });
+
+      if (m_clk == m_next_power_sample_clk) {
+        sample_power();
+        m_next_power_sample_clk += m_power_trace_interval;
       }
     };
 
+    Clk_t get_next_event_cycle() override {
+      Clk_t next_event_cycle = IDRAM::get_next_event_cycle();
+      if (m_power_trace_interval > 0) {
+        next_event_cycle = std::min(next_event_cycle, m_next_power_sample_clk);
+      }
+      return next_event_cycle;
+    };
+
     void init() override {
       RAMULATOR_DECLARE_SPECS();
       set_organization();
       set_timing_vals();
 
-      set_actions();
-      set_preqs();
-      set_rowhits();
-      set_rowopens();
       set_powers();
       create_nodes();
     };
@@ -235,22 +250,22 @@ class DDR5 : public IDRAM, public Implementation {
     void check_future_action(int command, const AddrVec_t& addr_vec) {
       switch (command) {
         case m_commands("REFab"):
-          m_future_actions.push_back({command, addr_vec, m_clk + m_timing_vals("nRFC1") - 1});
+          add_future_action({command, addr_vec, m_clk + m_timing_vals("nRFC1") - 1});
           break;
         case m_commands("REFsb"):
-          m_future_actions.push_back({command, addr_vec, m_clk + m_timing_vals("nRFCsb") - 1});
+          add_future_action({command, addr_vec, m_clk + m_timing_vals("nRFCsb") - 1});
           break;
         case m_commands("RFMab"):
-          m_future_actions.push_back({command, addr_vec, m_clk + m_timing_vals("nRFM1") - 1});
+          add_future_action({command, addr_vec, m_clk + m_timing_vals("nRFM1") - 1});
           break;
         case m_commands("RFMsb"):
-          m_future_actions.push_back({command, addr_vec, m_clk + m_timing_vals("nRFMsb") - 1});
+          add_future_action({command, addr_vec, m_clk + m_timing_vals("nRFMsb") - 1});
           break;
         case m_commands("DRFMab"):
-          m_future_actions.push_back({command, addr_vec, m_clk + m_timing_vals("nDRFMab") - 1});
+          add_future_action({command, addr_vec, m_clk + m_timing_vals("nDRFMab") - 1});
           break;
         case m_commands("DRFMsb"):
-          m_future_actions.push_back({command, addr_vec, m_clk + m_timing_vals("nDRFMsb") - 1});
+          add_future_action({command, addr_vec, m_clk + m_timing_vals("nDRFMsb") - 1});
           break;
         default:
           // Other commands do not require future actions
@@ -301,6 +316,11 @@ class DDR5 : public IDRAM, public Implementation {
       return m_channels[channel_id]->check_ready(command, addr_vec, m_clk);
     };
 
+    Clk_t get_ready_clk(int command, const AddrVec_t& addr_vec) override {
+      int channel_id = addr_vec[m_levels["channel"]];
+      return m_channels[channel_id]->get_ready_clk(command, addr_vec);
+    };
+
     bool check_rowbuffer_hit(int command, const AddrVec_t& addr_vec) override {
       int channel_id = addr_vec[m_levels["channel"]];
       return m_channels[channel_id]->check_rowbuffer_hit(command, addr_vec, m_clk);
@@ -483,6 +503,12 @@ class DDR5 : public IDRAM, public Implementation {
       m_timing_vals("nDRFMab") = 2 * m_BRC * JEDEC_rounding_DDR5(tRRFsb_TABLE[0][density_id], tCK_ps);
       m_timing_vals("nDRFMsb") = 2 * m_BRC * JEDEC_rounding_DDR5(tRRFsb_TABLE[1][density_id], tCK_ps);
 
+      // Power-down and self-refresh timings
+      m_timing_vals("nPD")  = std::max<int>(8, JEDEC_rounding_DDR5(7.5, tCK_ps));
+      m_timing_vals("nXP")  = std::max<int>(8, JEDEC_rounding_DDR5(7.5, tCK_ps));
+      m_timing_vals("nCSL") = JEDEC_rounding_DDR5(10, tCK_ps);
+      m_timing_vals("nXS")  = m_timing_vals("nRFC1") + JEDEC_rounding_DDR5(10, tCK_ps);
+
 
       // Overwrite timing parameters with any user-provided value
       // Rate and tCK should not be overwritten
@@ -544,16 +570,23 @@ class DDR5 : public IDRAM, public Implementation {
           {.level = "rank", .preceding = {"PREA"}, .following = {"ACT"}, .latency = V("nRP")},          
           /// RAS <-> REF
           {.level = "rank", .preceding = {"ACT"}, .following = {"REFab", "RFMab", "DRFMab"}, .latency = V("nRC")},          
-          {.level = "rank", .preceding = {"PRE", "PREsb"}, .following = {"REFab", "RFMab", "DRFMab"}, .latency = V("nRP")},          
-          {.level = "rank", .preceding = {"PREA"}, .following = {"REFab", "RFMab", "DRFMab", "REFsb", "RFMsb", "DRFMsb"}, .latency = V("nRP")},          
-          {.level = "rank", .preceding = {"RDA"}, .following = {"REFab", "RFMab", "DRFMab"}, .latency = V("nRP") + V("nRTP")},          
-          {.level = "rank", .preceding = {"WRA"}, .following = {"REFab", "RFMab", "DRFMab"}, .latency = V("nCWL") + V("nBL") + V("nWR") + V("nRP")},          
-          {.level = "rank", .preceding = {"REFab"}, .following = {"ACT", "PREA", "REFab", "RFMab", "DRFMab", "REFsb", "RFMsb", "DRFMsb"}, .latency = V("nRFC1")},          
-          {.level = "rank", .preceding = {"RFMab"}, .following = {"ACT", "PREA", "REFab", "RFMab", "DRFMab", "REFsb", "RFMsb", "DRFMsb"}, .latency = V("nRFM1")},          
-          {.level = "rank", .preceding = {"DRFMab"}, .following = {"ACT", "PREA", "REFab", "RFMab", "DRFMab", "REFsb", "RFMsb", "DRFMsb"}, .latency = V("nDRFMab")},          
-          {.level = "rank", .preceding = {"REFsb"},  .following = {"PREA", "REFab", "RFMab", "DRFMab"}, .latency = V("nRFCsb")},  
-          {.level = "rank", .preceding = {"RFMsb"},  .following = {"PREA", "REFab", "RFMab", "DRFMab"}, .latency = V("nRFMsb")},  
-          {.level = "rank", .preceding = {"DRFMsb"}, .following = {"PREA", "REFab", "RFMab", "DRFMab"}, .latency = V("nDRFMsb")},  
+          {.level = "rank", .preceding = {"PRE", "PREsb"}, .following = {"REFab", "RFMab", "DRFMab", "SRE"}, .latency = V("nRP")},          
+          {.level = "rank", .preceding = {"PREA"}, .following = {"REFab", "RFMab", "DRFMab", "REFsb", "RFMsb", "DRFMsb", "SRE"}, .latency = V("nRP")},          
+          {.level = "rank", .preceding = {"RDA"}, .following = {"REFab", "RFMab", "DRFMab", "SRE"}, .latency = V("nRP") + V("nRTP")},          
+          {.level = "rank", .preceding = {"WRA"}, .following = {"REFab", "RFMab", "DRFMab", "SRE"}, .latency = V("nCWL") + V("nBL") + V("nWR") + V("nRP")},          
+          {.level = "rank", .preceding = {"REFab"}, .following = {"ACT", "PREA", "REFab", "RFMab", "DRFMab", "REFsb", "RFMsb", "DRFMsb", "PDE", "SRE"}, .latency = V("nRFC1")},          
+          {.level = "rank", .preceding = {"RFMab"}, .following = {"ACT", "PREA", "REFab", "RFMab", "DRFMab", "REFsb", "RFMsb", "DRFMsb", "PDE", "SRE"}, .latency = V("nRFM1")},          
+          {.level = "rank", .preceding = {"DRFMab"}, .following = {"ACT", "PREA", "REFab", "RFMab", "DRFMab", "REFsb", "RFMsb", "DRFMsb", "PDE", "SRE"}, .latency = V("nDRFMab")},          
+          {.level = "rank", .preceding = {"REFsb"},  .following = {"PREA", "REFab", "RFMab", "DRFMab", "PDE", "SRE"}, .latency = V("nRFCsb")},  
+          {.level = "rank", .preceding = {"RFMsb"},  .following = {"PREA", "REFab", "RFMab", "DRFMab", "PDE", "SRE"}, .latency = V("nRFMsb")},  
+          {.level = "rank", .preceding = {"DRFMsb"}, .following = {"PREA", "REFab", "RFMab", "DRFMab", "PDE", "SRE"}, .latency = V("nDRFMsb")},  
+          /// Power-down and self-refresh
+          {.level = "rank", .preceding = {"RD", "RDA"}, .following = {"PDE", "SRE"}, .latency = V("nCL") + V("nBL") + 1},
+          {.level = "rank", .preceding = {"WR", "WRA"}, .following = {"PDE", "SRE"}, .latency = V("nCWL") + V("nBL") + V("nWR") + 1},
+          {.level = "rank", .preceding = {"PDE"}, .following = {"PDX"}, .latency = V("nPD")},
+          {.level = "rank", .preceding = {"SRE"}, .following = {"SRX"}, .latency = V("nCSL")},
+          {.level = "rank", .preceding = {"PDX"}, .following = all_commands, .latency = V("nXP")},
+          {.level = "rank", .preceding = {"SRX"}, .following = all_commands, .latency = V("nXS")},
           /*** Same Bank Group ***/ 
           /// CAS <-> CAS
           {.level = "bankgroup", .preceding = {"RD", "RDA"}, .following = {"RD", "RDA"}, .latency = V("nCCDL")},          
@@ -583,8 +616,9 @@ class DDR5 : public IDRAM, public Implementation {
 
     };
 
-    void set_actions() {
-      m_actions.resize(m_levels.size(), std::vector<ActionFunc_t<Node>>(m_commands.size()));
+  public:
+    inline static constexpr FuncMatrix<ActionFunc_t<Node>, DDR5> m_actions = [] {
+      FuncMatrix<ActionFunc_t<Node>, DDR5> m_actions {};
 
       // Rank Actions
       m_actions[m_levels["rank"]][m_commands["PREA"]] = Lambdas::Action::Rank::PREab<DDR5>;
@@ -594,6 +628,10 @@ class DDR5 : public IDRAM, public Implementation {
       m_actions[m_levels["rank"]][m_commands["RFMab_end"]] = Lambdas::Action::Rank::REFab_end<DDR5>;
       m_actions[m_levels["rank"]][m_commands["DRFMab"]] = Lambdas::Action::Rank::REFab<DDR5>;
       m_actions[m_levels["rank"]][m_commands["DRFMab_end"]] = Lambdas::Action::Rank::REFab_end<DDR5>;
+      m_actions[m_levels["rank"]][m_commands["PDE"]] = Lambdas::Action::Rank::PDE<DDR5>;
+      m_actions[m_levels["rank"]][m_commands["PDX"]] = Lambdas::Action::Rank::PowerUp<DDR5>;
+      m_actions[m_levels["rank"]][m_commands["SRE"]] = Lambdas::Action::Rank::SRE<DDR5>;
+      m_actions[m_levels["rank"]][m_commands["SRX"]] = Lambdas::Action::Rank::PowerUp<DDR5>;
       
       // Same-Bank Actions.
       m_actions[m_levels["bankgroup"]][m_commands["PREsb"]] = Lambdas::Action::BankGroup::PREsb<DDR5>;
@@ -611,46 +649,117 @@ class DDR5 : public IDRAM, public Implementation {
       m_actions[m_levels["bank"]][m_commands["PRE"]] = Lambdas::Action::Bank::PRE<DDR5>;
       m_actions[m_levels["bank"]][m_commands["RDA"]] = Lambdas::Action::Bank::PRE<DDR5>;
       m_actions[m_levels["bank"]][m_commands["WRA"]] = Lambdas::Action::Bank::PRE<DDR5>;
-    };
-
-    void set_preqs() {
-      m_preqs.resize(m_levels.size(), std::vector<PreqFunc_t<Node>>(m_commands.size()));
 
-      // Rank Preqs
-      m_preqs[m_levels["rank"]][m_commands["REFab"]]  = Lambdas::Preq::Rank::RequireAllBanksClosed<DDR5>;
-      m_preqs[m_levels["rank"]][m_commands["RFMab"]]  = Lambdas::Preq::Rank::RequireAllBanksClosed<DDR5>;
-      m_preqs[m_levels["rank"]][m_commands["DRFMab"]] = Lambdas::Preq::Rank::RequireAllBanksClosed<DDR5>;
+      return m_actions;
+    }();
+
+    inline static constexpr FuncMatrix<PreqFunc_t<Node>, DDR5> m_preqs = [] {
+      FuncMatrix<PreqFunc_t<Node>, DDR5> m_preqs {};
+
+      // Rank Preqs. A rank in power-down or self-refresh is woken up before anything else.
+      using Lambdas::Preq::Rank::RequirePowerUp;
+      m_preqs[m_levels["rank"]][m_commands["ACT"]]    = RequirePowerUp<DDR5>;
+      m_preqs[m_levels["rank"]][m_commands["PRE"]]    = RequirePowerUp<DDR5>;
+      m_preqs[m_levels["rank"]][m_commands["PREA"]]   = RequirePowerUp<DDR5>;
+      m_preqs[m_levels["rank"]][m_commands["PREsb"]]  = RequirePowerUp<DDR5>;
+      m_preqs[m_levels["rank"]][m_commands["RD"]]     = RequirePowerUp<DDR5>;
+      m_preqs[m_levels["rank"]][m_commands["WR"]]     = RequirePowerUp<DDR5>;
+      m_preqs[m_levels["rank"]][m_commands["RDA"]]    = RequirePowerUp<DDR5>;
+      m_preqs[m_levels["rank"]][m_commands["WRA"]]    = RequirePowerUp<DDR5>;
+      m_preqs[m_levels["rank"]][m_commands["PDE"]]    = RequirePowerUp<DDR5>;
+      m_preqs[m_levels["rank"]][m_commands["REFab"]]  = RequirePowerUp<DDR5, Lambdas::Preq::Rank::RequireAllBanksClosed<DDR5>>;
+      m_preqs[m_levels["rank"]][m_commands["RFMab"]]  = RequirePowerUp<DDR5, Lambdas::Preq::Rank::RequireAllBanksClosed<DDR5>>;
+      m_preqs[m_levels["rank"]][m_commands["DRFMab"]] = RequirePowerUp<DDR5, Lambdas::Preq::Rank::RequireAllBanksClosed<DDR5>>;
+      m_preqs[m_levels["rank"]][m_commands["SRE"]]    = RequirePowerUp<DDR5, Lambdas::Preq::Rank::RequireAllBanksClosed<DDR5>>;
 
       // Same-Bank Preqs.
-      m_preqs[m_levels["rank"]][m_commands["REFsb"]]  = Lambdas::Preq::Rank::RequireSameBanksClosed<DDR5>;
-      m_preqs[m_levels["rank"]][m_commands["RFMsb"]]  = Lambdas::Preq::Rank::RequireSameBanksClosed<DDR5>;
-      m_preqs[m_levels["rank"]][m_commands["DRFMsb"]] = Lambdas::Preq::Rank::RequireSameBanksClosed<DDR5>;
+      m_preqs[m_levels["rank"]][m_commands["REFsb"]]  = RequirePowerUp<DDR5, Lambdas::Preq::Rank::RequireSameBanksClosed<DDR5>>;
+      m_preqs[m_levels["rank"]][m_commands["RFMsb"]]  = RequirePowerUp<DDR5, Lambdas::Preq::Rank::RequireSameBanksClosed<DDR5>>;
+      m_preqs[m_levels["rank"]][m_commands["DRFMsb"]] = RequirePowerUp<DDR5, Lambdas::Preq::Rank::RequireSameBanksClosed<DDR5>>;
 
       // Bank Preqs
       m_preqs[m_levels["bank"]][m_commands["RD"]] = Lambdas::Preq::Bank::RequireRowOpen<DDR5>;
       m_preqs[m_levels["bank"]][m_commands["WR"]] = Lambdas::Preq::Bank::RequireRowOpen<DDR5>;
       m_preqs[m_levels["bank"]][m_commands["ACT"]] = Lambdas::Preq::Bank::RequireRowOpen<DDR5>;
       m_preqs[m_levels["bank"]][m_commands["PRE"]] = Lambdas::Preq::Bank::RequireBankClosed<DDR5>;
-    };
 
-    void set_rowhits() {
-      m_rowhits.resize(m_levels.size(), std::vector<RowhitFunc_t<Node>>(m_commands.size()));
+      return m_preqs;
+    }();
+
+    inline static constexpr FuncMatrix<RowhitFunc_t<Node>, DDR5> m_rowhits = [] {
+      FuncMatrix<RowhitFunc_t<Node>, DDR5> m_rowhits {};
 
       m_rowhits[m_levels["bank"]][m_commands["RD"]] = Lambdas::RowHit::Bank::RDWR<DDR5>;
       m_rowhits[m_levels["bank"]][m_commands["WR"]] = Lambdas::RowHit::Bank::RDWR<DDR5>;
-    }
 
+      return m_rowhits;
+    }();
 
-    void set_rowopens() {
-      m_rowopens.resize(m_levels.size(), std::vector<RowhitFunc_t<Node>>(m_commands.size()));
+
+    inline static constexpr FuncMatrix<RowopenFunc_t<Node>, DDR5> m_rowopens = [] {
+      FuncMatrix<RowopenFunc_t<Node>, DDR5> m_rowopens {};
 
       m_rowopens[m_levels["bank"]][m_commands["RD"]] = Lambdas::RowOpen::Bank::RDWR<DDR5>;
       m_rowopens[m_levels["bank"]][m_commands["WR"]] = Lambdas::RowOpen::Bank::RDWR<DDR5>;
-    }
 
+      return m_rowopens;
+    }();
+
+    inline static constexpr FuncMatrix<PowerFunc_t<Node>, DDR5> m_powers = [] {
+      FuncMatrix<PowerFunc_t<Node>, DDR5> m_powers {};
+
+      m_powers[m_levels["bank"]][m_commands["ACT"]] = Lambdas::Power::Bank::ACT<DDR5>;
+      m_powers[m_levels["bank"]][m_commands["PRE"]] = Lambdas::Power::Bank::PRE<DDR5>;
+      m_powers[m_levels["bank"]][m_commands["RD"]]  = Lambdas::Power::Bank::RD<DDR5>;
+      m_powers[m_levels["bank"]][m_commands["WR"]]  = Lambdas::Power::Bank::WR<DDR5>;
+      m_powers[m_levels["bank"]][m_commands["RDA"]] = Lambdas::Power::Bank::AutoPRE<DDR5>;
+      m_powers[m_levels["bank"]][m_commands["WRA"]] = Lambdas::Power::Bank::AutoPRE<DDR5>;
+
+      m_powers[m_levels["rank"]][m_commands["REFsb"]] = Lambdas::Power::Rank::REFsb<DDR5>;
+      m_powers[m_levels["rank"]][m_commands["REFsb_end"]] = Lambdas::Power::Rank::REFsb_end<DDR5>;
+      m_powers[m_levels["rank"]][m_commands["RFMsb"]] = Lambdas::Power::Rank::RFMsb<DDR5>;
+      m_powers[m_levels["rank"]][m_commands["RFMsb_end"]] = Lambdas::Power::Rank::RFMsb_end<DDR5>;
+      m_powers[m_levels["rank"]][m_commands["DRFMsb"]] = Lambdas::Power::Rank::REFsb<DDR5>;
+      m_powers[m_levels["rank"]][m_commands["DRFMsb_end"]] = Lambdas::Power::Rank::REFsb_end<DDR5>;
+
+      m_powers[m_levels["rank"]][m_commands["ACT"]] = Lambdas::Power::Rank::ACT<DDR5>;
+      m_powers[m_levels["rank"]][m_commands["PRE"]] = Lambdas::Power::Rank::PRE<DDR5>;
+      m_powers[m_levels["rank"]][m_commands["PREA"]] = Lambdas::Power::Rank::PREA<DDR5>;
+      m_powers[m_levels["rank"]][m_commands["REFab"]] = Lambdas::Power::Rank::REFab<DDR5>;
+      m_powers[m_levels["rank"]][m_commands["REFab_end"]] = Lambdas::Power::Rank::REFab_end<DDR5>;
+      m_powers[m_levels["rank"]][m_commands["RFMab"]] = Lambdas::Power::Rank::RFMab<DDR5>;
+      m_powers[m_levels["rank"]][m_commands["RFMab_end"]] = Lambdas::Power::Rank::RFMab_end<DDR5>;
+      m_powers[m_levels["rank"]][m_commands["DRFMab"]] = Lambdas::Power::Rank::RFMab<DDR5>;
+      m_powers[m_levels["rank"]][m_commands["DRFMab_end"]] = Lambdas::Power::Rank::RFMab_end<DDR5>;
+
+      m_powers[m_levels["rank"]][m_commands["PREsb"]] = Lambdas::Power::Rank::PREsb<DDR5>;
+
+      m_powers[m_levels["rank"]][m_commands["PDE"]] = Lambdas::Power::Rank::PDE<DDR5>;
+      m_powers[m_levels["rank"]][m_commands["PDX"]] = Lambdas::Power::Rank::PDX<DDR5>;
+      m_powers[m_levels["rank"]][m_commands["SRE"]] = Lambdas::Power::Rank::SRE<DDR5>;
+      m_powers[m_levels["rank"]][m_commands["SRX"]] = Lambdas::Power::Rank::SRX<DDR5>;
+
+      return m_powers;
+    }();
+
+  private:
     void set_powers() {
       m_drampower_enable = param<bool>("drampower_enable").default_val(false);
 
+      m_power_trace_interval = param<Clk_t>("power_trace_interval").desc("Write the energy of each rank every this many cycles (0 to disable).").default_val(0);
+      if (m_power_trace_interval < 0) {
+        throw ConfigurationError("Invalid power_trace_interval ({}) in {}!", m_power_trace_interval, get_name());
+      }
+      std::string power_trace_path;
+      std::string power_trace_format;
+      if (m_power_trace_interval > 0) {
+        if (!m_drampower_enable) {
+          throw ConfigurationError("{} has a power trace (power_trace_interval = {}) but drampower_enable is off!", get_name(), m_power_trace_interval);
+        }
+        power_trace_path = param<std::string>("power_trace_path").desc("Path to the power trace file.").required();
+        power_trace_format = param<std::string>("power_trace_format").desc("Format of the power trace (csv or binary).").default_val("csv");
+      }
+
       if (!m_drampower_enable)
         return;
 
@@ -676,6 +785,11 @@ class DDR5 : public IDRAM, public Implementation {
 
       m_power_debug = param<bool>("power_debug").default_val(false);
 
+      if (m_power_trace_interval > 0) {
+        m_power_trace.open(power_trace_path, power_trace_format);
+        m_next_power_sample_clk = m_power_trace_interval;
+      }
+
       // TODO: Check for multichannel configs.
       int num_channels = m_organization.count[m_levels["channel"]];
       int num_ranks = m_organization.count[m_levels["rank"]];
@@ -686,38 +800,14 @@ class DDR5 : public IDRAM, public Implementation {
           m_power_stats[i * num_ranks + j].cmd_counters.resize(m_cmds_counted.size(), 0);
         }
       }
-
-      m_powers.resize(m_levels.size(), std::vector<PowerFunc_t<Node>>(m_commands.size()));
-
-      m_powers[m_levels["bank"]][m_commands["ACT"]] = Lambdas::Power::Bank::ACT<DDR5>;
-      m_powers[m_levels["bank"]][m_commands["PRE"]] = Lambdas::Power::Bank::PRE<DDR5>;
-      m_powers[m_levels["bank"]][m_commands["RD"]]  = Lambdas::Power::Bank::RD<DDR5>;
-      m_powers[m_levels["bank"]][m_commands["WR"]]  = Lambdas::Power::Bank::WR<DDR5>;
-
-      // m_powers[m_levels["rank"]][m_commands["REFsb"]] = Lambdas::Power::Rank::REFsb<DDR5>;
-      // m_powers[m_levels["rank"]][m_commands["REFsb_end"]] = Lambdas::Power::Rank::REFsb_end<DDR5>;
-      m_powers[m_levels["rank"]][m_commands["RFMsb"]] = Lambdas::Power::Rank::RFMsb<DDR5>;
-      m_powers[m_levels["rank"]][m_commands["RFMsb_end"]] = Lambdas::Power::Rank::RFMsb_end<DDR5>;
-      // m_powers[m_levels["rank"]][m_commands["DRFMsb"]] = Lambdas::Power::Rank::REFsb<DDR5>;
-      // m_powers[m_levels["rank"]][m_commands["DRFMsb_end"]] = Lambdas::Power::Rank::REFsb_end<DDR5>;
-
-      m_powers[m_levels["rank"]][m_commands["ACT"]] = Lambdas::Power::Rank::ACT<DDR5>;
-      m_powers[m_levels["rank"]][m_commands["PRE"]] = Lambdas::Power::Rank::PRE<DDR5>;
-      m_powers[m_levels["rank"]][m_commands["PREA"]] = Lambdas::Power::Rank::PREA<DDR5>;
-      m_powers[m_levels["rank"]][m_commands["REFab"]] = Lambdas::Power::Rank::REFab<DDR5>;
-      m_powers[m_levels["rank"]][m_commands["REFab_end"]] = Lambdas::Power::Rank::REFab_end<DDR5>;
-      // m_powers[m_levels["rank"]][m_commands["RFMab"]] = Lambdas::Power::Rank::REFab<DDR5>;
-      // m_powers[m_levels["rank"]][m_commands["RFMab_end"]] = Lambdas::Power::Rank::REFab_end<DDR5>;
-      // m_powers[m_levels["rank"]][m_commands["DRFMab"]] = Lambdas::Power::Rank::REFab<DDR5>;
-      // m_powers[m_levels["rank"]][m_commands["DRFMab_end"]] = Lambdas::Power::Rank::REFab_end<DDR5>;
-
-      m_powers[m_levels["rank"]][m_commands["PREsb"]] = Lambdas::Power::Rank::PREsb<DDR5>;
+      m_sampled_residencies.resize(m_power_stats.size(), {.cmd_counters = std::vector<size_t>(m_cmds_counted.size(), 0)});
 
       // register stats
       register_stat(s_total_background_energy).name("total_background_energy");
       register_stat(s_total_cmd_energy).name("total_cmd_energy");
       register_stat(s_total_energy).name("total_energy");
       register_stat(s_total_rfm_energy).name("total_rfm_energy");
+      register_stat(s_total_powerdown_energy_saved).name("total_powerdown_energy_saved");
 
             
       for (auto& power_stat : m_power_stats){
@@ -728,6 +818,12 @@ class DDR5 : public IDRAM, public Implementation {
         register_stat(power_stat.pre_background_energy).name("pre_background_energy_rank{}", power_stat.rank_id);
         register_stat(power_stat.active_cycles).name("active_cycles_rank{}", power_stat.rank_id);
         register_stat(power_stat.idle_cycles).name("idle_cycles_rank{}", power_stat.rank_id);
+        register_stat(power_stat.powerdown_background_energy).name("powerdown_background_energy_rank{}", power_stat.rank_id);
+        register_stat(power_stat.selfrefresh_energy).name("selfrefresh_energy_rank{}", power_stat.rank_id);
+        register_stat(power_stat.powerdown_energy_saved).name("powerdown_energy_saved_rank{}", power_stat.rank_id);
+        register_stat(power_stat.active_powerdown_cycles).name("active_powerdown_cycles_rank{}", power_stat.rank_id);
+        register_stat(power_stat.precharge_powerdown_cycles).name("precharge_powerdown_cycles_rank{}", power_stat.rank_id);
+        register_stat(power_stat.selfrefresh_cycles).name("selfrefresh_cycles_rank{}", power_stat.rank_id);
       }
     }
 
@@ -743,6 +839,14 @@ class DDR5 : public IDRAM, public Implementation {
       if (!m_drampower_enable)
         return;
 
+      if (m_power_trace.is_open()) {
+        // The last (partial) interval
+        if (m_clk > m_next_power_sample_clk - m_power_trace_interval) {
+          sample_power();
+        }
+        m_power_trace.close();
+      }
+
       int num_channels = m_organization.count[m_levels["channel"]];
       int num_ranks = m_organization.count[m_levels["rank"]];
       for (int i = 0; i < num_channels; i++) {
@@ -752,10 +856,20 @@ class DDR5 : public IDRAM, public Implementation {
       }
     }
 
-    void process_rank_energy(PowerStats& rank_stats, Node* rank_node) {
-      
-      Lambdas::Power::Rank::finalize_rank<DDR5>(rank_node, 0, AddrVec_t(), m_clk);
+  private:
+    struct RankEnergy {
+      double act_background = 0, pre_background = 0, powerdown_background = 0, selfrefresh = 0;
+      double act_cmd = 0, pre_cmd = 0, rd_cmd = 0, wr_cmd = 0, ref_cmd = 0, rfm_cmd = 0;
+
+      double background() const { return act_background + pre_background + powerdown_background + selfrefresh; };
+      double refresh() const { return ref_cmd + rfm_cmd; };
+    };
 
+    /**
+     * @brief    Computes the energy of a rank (nJ) from the cycles it spent in each power state and the commands it received.
+     * 
+     */
+    RankEnergy compute_rank_energy(const PowerStats::Residency& residency) {
       size_t num_bankgroups = m_organization.count[m_levels["bankgroup"]];
 
       auto TS = [&](std::string_view timing) { return m_timing_vals(timing); };
@@ -764,45 +878,100 @@ class DDR5 : public IDRAM, public Implementation {
 
       double tCK_ns = (double) TS("tCK_ps") / 1000.0;
 
-      rank_stats.act_background_energy = (VE("VDD") * CE("IDD3N") + VE("VPP") * CE("IPP3N")) 
-                                            * rank_stats.active_cycles * tCK_ns / 1E3;
+      RankEnergy energy;
+      energy.act_background = (VE("VDD") * CE("IDD3N") + VE("VPP") * CE("IPP3N")) 
+                                 * residency.active_cycles * tCK_ns / 1E3;
+
+      energy.pre_background = (VE("VDD") * CE("IDD2N") + VE("VPP") * CE("IPP2N")) 
+                                 * residency.idle_cycles * tCK_ns / 1E3;
+
+      energy.powerdown_background = (VE("VDD") * CE("IDD3P") + VE("VPP") * CE("IPP3P")) 
+                                       * residency.active_powerdown_cycles * tCK_ns / 1E3
+                                  + (VE("VDD") * CE("IDD2P") + VE("VPP") * CE("IPP2P")) 
+                                       * residency.precharge_powerdown_cycles * tCK_ns / 1E3;
+
+      // Self-refresh current includes the refreshes done by the device itself
+      energy.selfrefresh = (VE("VDD") * CE("IDD6N") + VE("VPP") * CE("IPP6N")) 
+                              * residency.selfrefresh_cycles * tCK_ns / 1E3;
+
+      energy.act_cmd = (VE("VDD") * (CE("IDD0") - CE("IDD3N")) + VE("VPP") * (CE("IPP0") - CE("IPP3N"))) 
+                          * residency.cmd_counters[m_cmds_counted("ACT")] * TS("nRAS") * tCK_ns / 1E3;
+
+      energy.pre_cmd = (VE("VDD") * (CE("IDD0") - CE("IDD2N")) + VE("VPP") * (CE("IPP0") - CE("IPP2N"))) 
+                          * residency.cmd_counters[m_cmds_counted("PRE")] * TS("nRP")  * tCK_ns / 1E3;
 
-      rank_stats.pre_background_energy = (VE("VDD") * CE("IDD2N") + VE("VPP") * CE("IPP2N")) 
-                                            * rank_stats.idle_cycles * tCK_ns / 1E3;
+      energy.rd_cmd  = (VE("VDD") * (CE("IDD4R") - CE("IDD3N")) + VE("VPP") * (CE("IPP4R") - CE("IPP3N"))) 
+                          * residency.cmd_counters[m_cmds_counted("RD")] * TS("nBL") * tCK_ns / 1E3;
 
+      energy.wr_cmd  = (VE("VDD") * (CE("IDD4W") - CE("IDD3N")) + VE("VPP") * (CE("IPP4W") - CE("IPP3N"))) 
+                          * residency.cmd_counters[m_cmds_counted("WR")] * TS("nBL") * tCK_ns / 1E3;
 
-      double act_cmd_energy  = (VE("VDD") * (CE("IDD0") - CE("IDD3N")) + VE("VPP") * (CE("IPP0") - CE("IPP3N"))) 
-                                      * rank_stats.cmd_counters[m_cmds_counted("ACT")] * TS("nRAS") * tCK_ns / 1E3;
+      energy.ref_cmd = (VE("VDD") * (CE("IDD5B")) + VE("VPP") * (CE("IPP5B"))) 
+                          * residency.cmd_counters[m_cmds_counted("REF")] * TS("nRFC1") * tCK_ns / 1E3;
 
-      double pre_cmd_energy  = (VE("VDD") * (CE("IDD0") - CE("IDD2N")) + VE("VPP") * (CE("IPP0") - CE("IPP2N"))) 
-                                      * rank_stats.cmd_counters[m_cmds_counted("PRE")] * TS("nRP")  * tCK_ns / 1E3;
+      energy.rfm_cmd = (VE("VDD") * (CE("IDD0") - CE("IDD3N")) + VE("VPP") * (CE("IPP0") - CE("IPP3N"))) * num_bankgroups
+                          * residency.cmd_counters[m_cmds_counted("RFM")] * TS("nRFMsb") * tCK_ns / 1E3;
 
-      double rd_cmd_energy   = (VE("VDD") * (CE("IDD4R") - CE("IDD3N")) + VE("VPP") * (CE("IPP4R") - CE("IPP3N"))) 
-                                      * rank_stats.cmd_counters[m_cmds_counted("RD")] * TS("nBL") * tCK_ns / 1E3;
+      return energy;
+    }
 
-      double wr_cmd_energy   = (VE("VDD") * (CE("IDD4W") - CE("IDD3N")) + VE("VPP") * (CE("IPP4W") - CE("IPP3N"))) 
-                                      * rank_stats.cmd_counters[m_cmds_counted("WR")] * TS("nBL") * tCK_ns / 1E3;
+    /**
+     * @brief    Writes the energy of each rank since the last sample to the power trace.
+     * 
+     */
+    void sample_power() {
+      for (size_t i = 0; i < m_power_stats.size(); i++) {
+        auto residency = m_power_stats[i].get_residency(m_clk);
+        RankEnergy energy = compute_rank_energy(residency - m_sampled_residencies[i]);
+        m_power_trace.write(m_clk, m_power_stats[i].rank_id, energy.background(),
+                            energy.act_cmd + energy.pre_cmd + energy.rd_cmd + energy.wr_cmd, energy.refresh());
+        m_sampled_residencies[i] = std::move(residency);
+      }
+    }
 
-      double ref_cmd_energy  = (VE("VDD") * (CE("IDD5B")) + VE("VPP") * (CE("IPP5B"))) 
-                                      * rank_stats.cmd_counters[m_cmds_counted("REF")] * TS("nRFC1") * tCK_ns / 1E3;
+    void process_rank_energy(PowerStats& rank_stats, Node* rank_node) {
+      
+      auto residency = rank_stats.get_residency(m_clk);
+      Lambdas::Power::Rank::finalize_rank<DDR5>(rank_node, 0, AddrVec_t(), m_clk);
 
-      double rfm_cmd_energy = (VE("VDD") * (CE("IDD0") - CE("IDD3N")) + VE("VPP") * (CE("IPP0") - CE("IPP3N"))) * num_bankgroups
-                                      * rank_stats.cmd_counters[m_cmds_counted("RFM")] * TS("nRFMsb") * tCK_ns / 1E3;
+      auto TS = [&](std::string_view timing) { return m_timing_vals(timing); };
+      auto VE = [&](std::string_view voltage) { return m_voltage_vals(voltage); };
+      auto CE = [&](std::string_view current) { return m_current_vals(current); };
+
+      double tCK_ns = (double) TS("tCK_ps") / 1000.0;
 
-      rank_stats.total_background_energy = rank_stats.act_background_energy + rank_stats.pre_background_energy;
-      rank_stats.total_cmd_energy = act_cmd_energy 
-                                    + pre_cmd_energy 
-                                    + rd_cmd_energy
-                                    + wr_cmd_energy 
-                                    + ref_cmd_energy
-                                    + rfm_cmd_energy;
+      RankEnergy energy = compute_rank_energy(residency);
+
+      rank_stats.act_background_energy = energy.act_background;
+      rank_stats.pre_background_energy = energy.pre_background;
+      rank_stats.powerdown_background_energy = energy.powerdown_background;
+      rank_stats.selfrefresh_energy = energy.selfrefresh;
+
+      // The same cycles in active/precharge standby (with the refreshes issued by the controller in self-refresh)
+      double standby_energy = (VE("VDD") * CE("IDD3N") + VE("VPP") * CE("IPP3N")) 
+                                 * rank_stats.active_powerdown_cycles * tCK_ns / 1E3
+                            + (VE("VDD") * CE("IDD2N") + VE("VPP") * CE("IPP2N")) 
+                                 * (rank_stats.precharge_powerdown_cycles + rank_stats.selfrefresh_cycles) * tCK_ns / 1E3
+                            + (VE("VDD") * (CE("IDD5B")) + VE("VPP") * (CE("IPP5B"))) 
+                                 * ((double) rank_stats.selfrefresh_cycles / TS("nREFI")) * TS("nRFC1") * tCK_ns / 1E3;
+      rank_stats.powerdown_energy_saved = standby_energy - rank_stats.powerdown_background_energy - rank_stats.selfrefresh_energy;
+
+      rank_stats.total_background_energy = rank_stats.act_background_energy + rank_stats.pre_background_energy
+                                           + rank_stats.powerdown_background_energy + rank_stats.selfrefresh_energy;
+      rank_stats.total_cmd_energy = energy.act_cmd 
+                                    + energy.pre_cmd 
+                                    + energy.rd_cmd
+                                    + energy.wr_cmd 
+                                    + energy.ref_cmd
+                                    + energy.rfm_cmd;
 
       rank_stats.total_energy = rank_stats.total_background_energy + rank_stats.total_cmd_energy;
 
       s_total_background_energy += rank_stats.total_background_energy;
       s_total_cmd_energy += rank_stats.total_cmd_energy;
       s_total_energy += rank_stats.total_energy;
-      s_total_rfm_energy += rfm_cmd_energy;
+      s_total_rfm_energy += energy.rfm_cmd;
+      s_total_powerdown_energy_saved += rank_stats.powerdown_energy_saved;
 
       s_total_rfm_cycles[rank_stats.rank_id] = rank_stats.cmd_counters[m_cmds_counted("RFM")] * TS("nRFMsb");
     }
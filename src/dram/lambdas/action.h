@@ -16,7 +16,7 @@ namespace Bank {
   template <class T>
   void ACT(typename T::Node* node, int cmd, int target_id, Clk_t clk) {
     node->m_state = T::m_states["Opened"];
-    node->m_row_state[target_id] = T::m_states["Opened"];
+    node->m_row_state.open(target_id, T::m_states["Opened"]);
   };
 
   template <class T>
@@ -110,6 +110,21 @@ template <class T>
     }
   };
 
+  template <class T>
+  void PDE(typename T::Node* node, int cmd, int target_id, Clk_t clk) {
+    node->m_state = T::m_states["PowerDown"];
+  };
+
+  template <class T>
+  void SRE(typename T::Node* node, int cmd, int target_id, Clk_t clk) {
+    node->m_state = T::m_states["SelfRefresh"];
+  };
+
+  template <class T>
+  void PowerUp(typename T::Node* node, int cmd, int target_id, Clk_t clk) {
+    node->m_state = T::m_states["PowerUp"];
+  };
+
   }       // namespace Rank
 
 namespace Channel {
@@ -34,16 +34,37 @@ namespace Bank {
     }
   }
 
+  // The power lambdas run before the states of the nodes are updated, so the bank is still in its state before the command
+
   template <class T>
   void ACT(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
     Bank::debug<T>(node, "Incrementing ACT counter.", clk);
-    node->m_spec->m_power_stats[Bank::get_flat_rank_id<T>(node)].cmd_counters[T::m_cmds_counted("ACT")]++;
+    auto& cur_power_stats = node->m_spec->m_power_stats[Bank::get_flat_rank_id<T>(node)];
+    cur_power_stats.cmd_counters[T::m_cmds_counted("ACT")]++;
+    if (node->m_state != T::m_states["Opened"]) {
+      cur_power_stats.num_open_banks++;
+    }
   }
 
   template <class T>
   void PRE(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
     Bank::debug<T>(node, "Incrementing PRE counter.", clk);
-    node->m_spec->m_power_stats[Bank::get_flat_rank_id<T>(node)].cmd_counters[T::m_cmds_counted("PRE")]++;
+    auto& cur_power_stats = node->m_spec->m_power_stats[Bank::get_flat_rank_id<T>(node)];
+    cur_power_stats.cmd_counters[T::m_cmds_counted("PRE")]++;
+    if (node->m_state == T::m_states["Opened"]) {
+      cur_power_stats.num_open_banks--;
+    }
+  }
+
+  /**
+   * @brief    The precharge of RDA and WRA, which only closes the bank (the commands themselves are not counted).
+   * 
+   */
+  template <class T>
+  void AutoPRE(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
+    if (node->m_state == T::m_states["Opened"]) {
+      node->m_spec->m_power_stats[Bank::get_flat_rank_id<T>(node)].num_open_banks--;
+    }
   }
 
   template <class T>
@@ -93,46 +114,41 @@ namespace Rank {
     }
   }
 
+  /**
+   * @brief    The number of open banks of the rank, kept up to date by the bank power lambdas of ACT, PRE, RDA and WRA and by PREA and PREsb.
+   * 
+   */
   template <class T>
   int get_open_bank_count(typename T::Node* node) {
-    int bank_count = 0;
-    if constexpr (T::m_levels["bank"] - T::m_levels["rank"] == 1) {
-      for (auto bank: node->m_child_nodes) {
-        if (bank->m_state == T::m_states["Opened"]) {
-          bank_count++;
-        }
-      }
-    } else if constexpr (T::m_levels["bank"] - T::m_levels["rank"] == 2) {
-      for (auto bg : node->m_child_nodes) {
-        for (auto bank: bg->m_child_nodes) {
-          if (bank->m_state == T::m_states["Opened"]) {
-              bank_count++;
-          }
-        }
-      }
-    }
-    return bank_count;
+    return node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)].num_open_banks;
   }
 
+  /**
+   * @brief    The number of refreshing banks of the rank, kept up to date by the rank power lambdas of the refresh commands and their _end.
+   * 
+   */
   template <class T>
   int get_refreshing_bank_count(typename T::Node* node) {
-    int bank_count = 0;
+    return node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)].num_refreshing_banks;
+  }
+
+  template <class T>
+  int get_bank_count(typename T::Node* node) {
     if constexpr (T::m_levels["bank"] - T::m_levels["rank"] == 1) {
-      for (auto bank: node->m_child_nodes) {
-        if (bank->m_state == T::m_states["Refreshing"]) {
-          bank_count++;
-        }
-      }
+      return node->m_child_nodes.size();
     } else if constexpr (T::m_levels["bank"] - T::m_levels["rank"] == 2) {
-      for (auto bg : node->m_child_nodes) {
-        for (auto bank: bg->m_child_nodes) {
-          if (bank->m_state == T::m_states["Refreshing"]) {
-              bank_count++;
-          }
-        }
-      }
+      return node->m_child_nodes.size() * node->m_child_nodes[0]->m_child_nodes.size();
     }
-    return bank_count;
+    return 0;
+  }
+
+  /**
+   * @brief    The number of banks a same-bank command (e.g., REFsb, RFMsb) targets: the same bank in one or in every bank group.
+   * 
+   */
+  template <class T>
+  int get_same_bank_count(typename T::Node* node, const AddrVec_t& addr_vec) {
+    return addr_vec[T::m_levels["bankgroup"]] == -1 ? node->m_child_nodes.size() : 1;
   }
 
   template <class T>
@@ -174,6 +190,7 @@ namespace Rank {
     assert(get_refreshing_bank_count<T>(node) == 0 && "PREA should not be called when there are refreshing banks");
 
     cur_power_stats.cmd_counters[T::m_cmds_counted("PRE")] += get_open_bank_count<T>(node);
+    cur_power_stats.num_open_banks = 0;
     Rank::debug<T>(node, "Incrementing PRE counter.", clk);
     if (!is_rank_idle) {
       cur_power_stats.active_cycles += clk - cur_power_stats.active_start_cycle;
@@ -189,6 +206,7 @@ namespace Rank {
     Rank::debug<T>(node, "------REFab------", clk);
     auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
     cur_power_stats.cmd_counters[T::m_cmds_counted("REF")]++;
+    cur_power_stats.num_refreshing_banks = get_bank_count<T>(node);
 
     // We assume rank is idle when REF is called
 
@@ -202,6 +220,7 @@ namespace Rank {
   void REFab_end(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
     Rank::debug<T>(node, "------REFab_end------", clk);
     auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
+    cur_power_stats.num_refreshing_banks = 0;
 
     cur_power_stats.idle_start_cycle = clk;
     std::string msg = "Refresh ends. idle_start_cycle: " + std::to_string(cur_power_stats.idle_start_cycle);
@@ -214,6 +233,7 @@ namespace Rank {
     Rank::debug<T>(node, "------VRR------", clk);
     auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
     bool is_rank_idle = get_open_bank_count<T>(node) == 0 && get_refreshing_bank_count<T>(node) == 0;
+    cur_power_stats.num_refreshing_banks++;
 
     if (is_rank_idle) {
       cur_power_stats.idle_cycles += clk - cur_power_stats.idle_start_cycle;
@@ -229,6 +249,7 @@ namespace Rank {
     Rank::debug<T>(node, "------VRR_end------", clk);
     auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
     bool is_rank_going_idle = get_open_bank_count<T>(node) == 0 && get_refreshing_bank_count<T>(node) == 1;
+    cur_power_stats.num_refreshing_banks--;
 
     if (is_rank_going_idle) {
       cur_power_stats.active_cycles += clk - cur_power_stats.active_start_cycle;
@@ -246,6 +267,7 @@ namespace Rank {
     bool is_rank_idle = get_open_bank_count<T>(node) == 0 && get_refreshing_bank_count<T>(node) == 0;
 
     cur_power_stats.cmd_counters[T::m_cmds_counted("RFM")]++;
+    cur_power_stats.num_refreshing_banks += get_same_bank_count<T>(node, addr_vec);
     if (is_rank_idle) {
       cur_power_stats.idle_cycles += clk - cur_power_stats.idle_start_cycle;
       cur_power_stats.active_start_cycle = clk;
@@ -261,6 +283,7 @@ namespace Rank {
     auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
     size_t num_bankgroups = node->m_child_nodes.size();
     bool is_rank_going_idle = get_open_bank_count<T>(node) == 0 && get_refreshing_bank_count<T>(node) == num_bankgroups;
+    cur_power_stats.num_refreshing_banks -= get_same_bank_count<T>(node, addr_vec);
 
     if (is_rank_going_idle) {
       cur_power_stats.active_cycles += clk - cur_power_stats.active_start_cycle;
@@ -278,6 +301,7 @@ namespace Rank {
     bool is_rank_idle = get_open_bank_count<T>(node) == 0 && get_refreshing_bank_count<T>(node) == 0;
 
     cur_power_stats.cmd_counters[T::m_cmds_counted("RRFM")]++;
+    cur_power_stats.num_refreshing_banks += get_same_bank_count<T>(node, addr_vec);
     if (is_rank_idle) {
       cur_power_stats.idle_cycles += clk - cur_power_stats.idle_start_cycle;
       cur_power_stats.active_start_cycle = clk;
@@ -293,6 +317,7 @@ namespace Rank {
     auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
     size_t num_bankgroups = node->m_child_nodes.size();
     bool is_rank_going_idle = get_open_bank_count<T>(node) == 0 && get_refreshing_bank_count<T>(node) == num_bankgroups;
+    cur_power_stats.num_refreshing_banks -= get_same_bank_count<T>(node, addr_vec);
 
     if (is_rank_going_idle) {
       cur_power_stats.active_cycles += clk - cur_power_stats.active_start_cycle;
@@ -303,6 +328,38 @@ namespace Rank {
     }
   }
 
+  /**
+   * @brief    Same-bank refreshes (REFsb, DRFMsb) are not in the energy model, they only keep the refreshing banks up to date.
+   * 
+   */
+  template <class T>
+  void REFsb(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
+    Rank::debug<T>(node, "------REFsb------", clk);
+    node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)].num_refreshing_banks += get_same_bank_count<T>(node, addr_vec);
+  }
+
+  template <class T>
+  void REFsb_end(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
+    Rank::debug<T>(node, "------REFsb_end------", clk);
+    node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)].num_refreshing_banks -= get_same_bank_count<T>(node, addr_vec);
+  }
+
+  /**
+   * @brief    All-bank RFMs (RFMab, DRFMab) are not in the energy model, they only keep the refreshing banks up to date.
+   * 
+   */
+  template <class T>
+  void RFMab(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
+    Rank::debug<T>(node, "------RFMab------", clk);
+    node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)].num_refreshing_banks = get_bank_count<T>(node);
+  }
+
+  template <class T>
+  void RFMab_end(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
+    Rank::debug<T>(node, "------RFMab_end------", clk);
+    node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)].num_refreshing_banks = 0;
+  }
+
   template <class T>
   void PREsb(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
     auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
@@ -322,6 +379,7 @@ namespace Rank {
     }
 
     cur_power_stats.cmd_counters[T::m_cmds_counted("PRE")] += open_target_banks;
+    cur_power_stats.num_open_banks -= open_target_banks;
     if (is_rank_going_idle) {
       cur_power_stats.active_cycles += clk - cur_power_stats.active_start_cycle;
       cur_power_stats.idle_start_cycle = clk;
@@ -332,17 +390,76 @@ namespace Rank {
   }
 
   template <class T>
-  void finalize_rank(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
-    Rank::debug<T>(node, "------finalize_rank------", clk);
+  void PDE(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
+    Rank::debug<T>(node, "------PDE------", clk);
     auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
 
-    if (cur_power_stats.cur_power_state == PowerStats::PowerState::IDLE) {
-      cur_power_stats.idle_cycles += clk - cur_power_stats.idle_start_cycle;
-    } else if (cur_power_stats.cur_power_state == PowerStats::PowerState::ACTIVE) {
+    // Power-down keeps the banks as they are, so the rank returns to the same state on exit
+    if (cur_power_stats.cur_power_state == PowerStats::PowerState::ACTIVE) {
       cur_power_stats.active_cycles += clk - cur_power_stats.active_start_cycle;
-    } else if (cur_power_stats.cur_power_state == PowerStats::PowerState::REFRESHING) {
-      // do nothing
+    } else if (cur_power_stats.cur_power_state == PowerStats::PowerState::IDLE) {
+      cur_power_stats.idle_cycles += clk - cur_power_stats.idle_start_cycle;
     }
+    cur_power_stats.pre_powerdown_state = cur_power_stats.cur_power_state;
+    cur_power_stats.powerdown_start_cycle = clk;
+    std::string msg = "Power-down starts. powerdown_start_cycle: " + std::to_string(cur_power_stats.powerdown_start_cycle);
+    Rank::debug<T>(node, msg, clk);
+    cur_power_stats.cur_power_state = PowerStats::PowerState::POWER_DOWN;
+  }
+
+  template <class T>
+  void PDX(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
+    Rank::debug<T>(node, "------PDX------", clk);
+    auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
+
+    if (cur_power_stats.pre_powerdown_state == PowerStats::PowerState::ACTIVE) {
+      cur_power_stats.active_powerdown_cycles += clk - cur_power_stats.powerdown_start_cycle;
+      cur_power_stats.active_start_cycle = clk;
+    } else {
+      cur_power_stats.precharge_powerdown_cycles += clk - cur_power_stats.powerdown_start_cycle;
+      cur_power_stats.idle_start_cycle = clk;
+    }
+    std::string msg = "Power-down ends. active_powerdown_cycles: " + std::to_string(cur_power_stats.active_powerdown_cycles) + "    precharge_powerdown_cycles: " + std::to_string(cur_power_stats.precharge_powerdown_cycles);
+    Rank::debug<T>(node, msg, clk);
+    cur_power_stats.cur_power_state = cur_power_stats.pre_powerdown_state;
+  }
+
+  template <class T>
+  void SRE(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
+    Rank::debug<T>(node, "------SRE------", clk);
+    auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
+
+    // All banks are closed before self-refresh entry
+    cur_power_stats.idle_cycles += clk - cur_power_stats.idle_start_cycle;
+    cur_power_stats.powerdown_start_cycle = clk;
+    std::string msg = "Self-refresh starts. idle_cycles: " + std::to_string(cur_power_stats.idle_cycles);
+    Rank::debug<T>(node, msg, clk);
+    cur_power_stats.cur_power_state = PowerStats::PowerState::SELF_REFRESH;
+  }
+
+  template <class T>
+  void SRX(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
+    Rank::debug<T>(node, "------SRX------", clk);
+    auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
+
+    cur_power_stats.selfrefresh_cycles += clk - cur_power_stats.powerdown_start_cycle;
+    cur_power_stats.idle_start_cycle = clk;
+    std::string msg = "Self-refresh ends. selfrefresh_cycles: " + std::to_string(cur_power_stats.selfrefresh_cycles);
+    Rank::debug<T>(node, msg, clk);
+    cur_power_stats.cur_power_state = PowerStats::PowerState::IDLE;
+  }
+
+  template <class T>
+  void finalize_rank(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
+    Rank::debug<T>(node, "------finalize_rank------", clk);
+    auto& cur_power_stats = node->m_spec->m_power_stats[Rank::get_flat_rank_id<T>(node)];
+
+    auto residency = cur_power_stats.get_residency(clk);
+    cur_power_stats.active_cycles = residency.active_cycles;
+    cur_power_stats.idle_cycles = residency.idle_cycles;
+    cur_power_stats.active_powerdown_cycles = residency.active_powerdown_cycles;
+    cur_power_stats.precharge_powerdown_cycles = residency.precharge_powerdown_cycles;
+    cur_power_stats.selfrefresh_cycles = residency.selfrefresh_cycles;
   }
 
 }       // namespace Rank
@@ -12,7 +12,7 @@ int RequireRowOpen(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, C
   switch (node->m_state) {
     case T::m_states["Closed"]: return T::m_commands["ACT"];
     case T::m_states["Opened"]: {
-      if (node->m_row_state.find(addr_vec[T::m_levels["row"]]) != node->m_row_state.end()) {
+      if (node->m_row_state.is_open(addr_vec[T::m_levels["row"]])) {
         return cmd;
       } else {
         return T::m_commands["PRE"];
@@ -85,6 +85,24 @@ int RequireSameBanksClosed(typename T::Node* node, int cmd, const AddrVec_t& add
     return T::m_commands["PREsb"];
   }
 };
+
+/**
+ * @brief    Wakes up a rank in power-down or self-refresh before checking the other prerequisites (Preq) of the command.
+ * 
+ */
+template <class T, PreqFunc_t<typename T::Node> Preq = nullptr>
+int RequirePowerUp(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk) {
+  if (node->m_state == T::m_states["PowerDown"]) {
+    return T::m_commands["PDX"];
+  } else if (node->m_state == T::m_states["SelfRefresh"]) {
+    return T::m_commands["SRX"];
+  }
+  if constexpr (Preq != nullptr) {
+    return Preq(node, cmd, addr_vec, clk);
+  }
+  // Commands to the rank itself have no other prerequisite, the others may have one at a lower level
+  return T::m_command_scopes[cmd] == T::m_levels["rank"] ? cmd : -1;
+};
 }       // namespace Rank
 namespace Channel {
   template <class T>
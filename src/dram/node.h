@@ -1,14 +1,16 @@
 #ifndef RAMULATOR_DRAM_NODE_H
 #define RAMULATOR_DRAM_NODE_H
 
+#include <array>
 #include <vector>
-#include <map>
-#include <deque>
+#include <memory>
 #include <functional>
 #include <concepts>
 
 #include "base/type.h"
+#include "base/inline_vector.h"
 #include "dram/spec.h"
+#include "dram/timing.h"
 
 namespace Ramulator {
 
@@ -26,6 +28,81 @@ concept IsDRAMSpec = requires(T t) {
 // };
 
 
+/**
+ * @brief     The open rows of a bank-ish node.
+ * @details
+ * Holds up to MaxOpenRows (row id, row state) pairs inline. Standards that can have more than one row 
+ * open per bank opt in by defining a static constexpr int m_max_open_rows before their Node.
+ * 
+ */
+template<int MaxOpenRows>
+class RowBufferState {
+  public:
+    using RowId_t = int;
+    using RowState_t = int;
+
+  private:
+    struct OpenRow {
+      RowId_t row;
+      RowState_t state;
+    };
+    InlineVector<OpenRow, MaxOpenRows> m_open_rows;
+
+  public:
+    bool is_open(RowId_t row) const {
+      for (const auto& open_row : m_open_rows) {
+        if (open_row.row == row) {
+          return true;
+        }
+      }
+      return false;
+    };
+
+    void open(RowId_t row, RowState_t state) {
+      for (auto& open_row : m_open_rows) {
+        if (open_row.row == row) {
+          open_row.state = state;
+          return;
+        }
+      }
+      m_open_rows.push_back({row, state});
+    };
+
+    void clear() { m_open_rows.clear(); };
+    bool empty() const { return m_open_rows.empty(); };
+};
+
+/**
+ * @brief     The open row of a bank-ish node in a standard with (at most) one open row per bank.
+ * 
+ */
+template<>
+class RowBufferState<1> {
+  public:
+    using RowId_t = int;
+    using RowState_t = int;
+
+  private:
+    RowId_t m_open_row = -1;        // -1 if no row is open
+    RowState_t m_open_row_state = -1;
+
+  public:
+    bool is_open(RowId_t row) const { return m_open_row != -1 && m_open_row == row; };
+    void open(RowId_t row, RowState_t state) { m_open_row = row; m_open_row_state = state; };
+    void clear() { m_open_row = -1; m_open_row_state = -1; };
+    bool empty() const { return m_open_row == -1; };
+};
+
+template<typename T>
+constexpr int get_max_open_rows() {
+  if constexpr (requires { T::m_max_open_rows; }) {
+    return T::m_max_open_rows;
+  } else {
+    return 1;
+  }
+};
+
+
 /**
  * @brief     CRTP-ish (?) base class of a DRAM Device Node
  * 
@@ -44,32 +121,28 @@ struct DRAMNodeBase {
 
     int m_state = -1;      // The state of the node
 
-    std::vector<Clk_t> m_cmd_ready_clk;             // The next cycle that each command can be issued again at this level
-    std::vector<std::deque<Clk_t>> m_cmd_history;   // Issue-history of each command at this level
+    std::unique_ptr<DRAMTimingState<T>> m_channel_timing;   // Owns the timing states, if I am a channel
+    DRAMTimingState<T>* m_timing = nullptr;                 // The timing states of all nodes in my channel
 
     using RowId_t = int;
     using RowState_t = int;
-    std::map<RowId_t, RowState_t> m_row_state;  // The state of the rows, if I am a bank-ish node
+    RowBufferState<get_max_open_rows<T>()> m_row_state;  // The state of the open rows, if I am a bank-ish node
 
     DRAMNodeBase(T* spec, NodeType* parent, int level, int id):
     m_spec(spec), m_parent_node(parent), m_level(level), m_node_id(id) {
-      int num_cmds = T::m_commands.size();
-      m_cmd_ready_clk.resize(num_cmds, -1);
-      m_cmd_history.resize(num_cmds);
-      for (int cmd = 0; cmd < num_cmds; cmd++) {
-        int window = 0;
-        for (const auto& t : spec->m_timing_cons[level][cmd]) {
-          window = std::max(window, t.window);
-        }
-        if (window != 0) {
-          m_cmd_history[cmd].resize(window, -1);
-        } else {
-          m_cmd_history[cmd].clear();
+      m_state = spec->m_init_states[m_level];
+
+      if (!parent) {
+        // I am a channel
+        if (spec->m_state_epochs.size() <= static_cast<size_t>(id)) {
+          spec->m_state_epochs.resize(id + 1, 0);
         }
+        m_channel_timing = std::make_unique<DRAMTimingState<T>>(spec);
+        m_timing = m_channel_timing.get();
+      } else {
+        m_timing = parent->m_timing;
       }
 
-      m_state = spec->m_init_states[m_level];
-
       // Recursively construct next levels
       int next_level = level + 1;
       int last_level = T::m_levels["row"];
@@ -89,6 +162,10 @@ struct DRAMNodeBase {
     };
 
     void update_states(int command, const AddrVec_t& addr_vec, Clk_t clk) {
+      if (!m_parent_node) {
+        m_spec->m_state_epochs[m_node_id]++;
+      }
+
       int child_id = addr_vec[m_level+1];
       if (m_spec->m_actions[m_level][command]) {
         // update the state machine at this level
@@ -131,60 +208,12 @@ struct DRAMNodeBase {
       }
     };
 
+    /**
+     * @brief     Updates the timing of all nodes in my channel. Only called on channel nodes.
+     * 
+     */
     void update_timing(int command, const AddrVec_t& addr_vec, Clk_t clk) {
-      /************************************************
-       *         Update Sibling Node Timing
-       ***********************************************/
-      if (m_node_id != addr_vec[m_level] && addr_vec[m_level] != -1) {
-        for (const auto& t : m_spec->m_timing_cons[m_level][command]) {
-          if (!t.sibling) {
-            // not sibling timing parameter
-            continue; 
-          }
-
-          // update earliest schedulable time of every command
-          Clk_t future = clk + t.val;
-          m_cmd_ready_clk[t.cmd] = std::max(m_cmd_ready_clk[t.cmd], future); 
-        }
-        // stop recursion
-        return;
-      }
-
-      /************************************************
-       *          Update Target Node Timing
-       ***********************************************/
-      // Update history
-      if (m_cmd_history[command].size()) {
-        m_cmd_history[command].pop_back();
-        m_cmd_history[command].push_front(clk); 
-      }
-
-      for (const auto& t : m_spec->m_timing_cons[m_level][command]) {
-        if (t.sibling) {
-          continue; 
-        }
-
-        // Get the oldest history
-        Clk_t past = m_cmd_history[command][t.window-1];
-        if (past < 0) {
-          // not enough history
-          continue; 
-        }
-
-        // update earliest schedulable time of every command
-        Clk_t future = past + t.val;
-        m_cmd_ready_clk[t.cmd] = std::max(m_cmd_ready_clk[t.cmd], future);
-      }
-
-      if (!m_child_nodes.size()) {
-        // stop recursion: updated all levels
-        return; 
-      }
-
-      // recursively update all of my children
-      for (auto child : m_child_nodes) {
-        child->update_timing(command, addr_vec, clk);
-      }
+      m_timing->update_timing(command, addr_vec, clk);
     };
 
     int get_preq_command(int command, const AddrVec_t& addr_vec, Clk_t m_clk) {
@@ -206,29 +235,20 @@ struct DRAMNodeBase {
       return m_child_nodes[child_id]->get_preq_command(command, addr_vec, m_clk);
     };
 
+    /**
+     * @brief     Checks the timing of all nodes on the path of the command. Only called on channel nodes.
+     * 
+     */
     bool check_ready(int command, const AddrVec_t& addr_vec, Clk_t clk) {
-      if (m_cmd_ready_clk[command] != -1 && clk < m_cmd_ready_clk[command]) {
-        // stop recursion: the check failed at this level
-        return false; 
-      }
-
-      int child_id = addr_vec[m_level+1];
-      if (m_level == m_spec->m_command_scopes[command] || !m_child_nodes.size()) {
-        // stop recursion: the check passed at all levels
-        return true; 
-      }
+      return m_timing->check_ready(command, addr_vec, clk);
+    };
 
-      if (child_id == -1) {
-        // if it is a same bank command, recurse all children in rank level
-        bool ready = true;
-        for (auto child : m_child_nodes) {
-          ready = ready && child->check_ready(command, addr_vec, clk);
-        }
-        return ready;
-      } else {
-        // recursively check my child
-        return m_child_nodes[child_id]->check_ready(command, addr_vec, clk);
-      }
+    /**
+     * @brief     Returns the earliest cycle allowed by the timing of all nodes on the path of the command. Only called on channel nodes.
+     * 
+     */
+    Clk_t get_ready_clk(int command, const AddrVec_t& addr_vec) {
+      return m_timing->get_ready_clk(command, addr_vec);
     };
 
     bool check_rowbuffer_hit(int command, const AddrVec_t& addr_vec, Clk_t m_clk) {
@@ -265,24 +285,25 @@ struct DRAMNodeBase {
 };
 
 template<class T>
-using ActionFunc_t = std::function<void(typename T::Node* node, int cmd, int target_id, Clk_t clk)>;
+using ActionFunc_t = void(*)(typename T::Node* node, int cmd, int target_id, Clk_t clk);
 template<class T>
-using PreqFunc_t   = std::function<int (typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk)>;
+using PreqFunc_t   = int (*)(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk);
 template<class T>
-using RowhitFunc_t = std::function<bool(typename T::Node* node, int cmd, int target_id, Clk_t clk)>;
+using RowhitFunc_t = bool(*)(typename T::Node* node, int cmd, int target_id, Clk_t clk);
 template<class T>
-using RowopenFunc_t = std::function<bool(typename T::Node* node, int cmd, int target_id, Clk_t clk)>;
+using RowopenFunc_t = bool(*)(typename T::Node* node, int cmd, int target_id, Clk_t clk);
 template<class T>
-using PowerFunc_t = std::function<void(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk)>;
-
-template<typename T>
-using FuncMatrix = std::vector<std::vector<T>>;
+using PowerFunc_t = void(*)(typename T::Node* node, int cmd, const AddrVec_t& addr_vec, Clk_t clk);
 
-// TODO: Enable easy syntax for FuncMatrix lookup
-// template<typename T, int N, int M>
-// class FuncMatrix : public std::array<std::array<T, M>, N> {
-
-// };
+/**
+ * @brief    A [level][command] table of plain function pointers.
+ * @details
+ * The standards build their tables as constexpr static members, so the lookup is a load from a
+ * read-only table and the call goes straight to the lambda (no std::function type erasure).
+ *
+ */
+template<typename F, class Spec>
+using FuncMatrix = std::array<std::array<F, Spec::m_commands.size()>, Spec::m_levels.size()>;
 
 }        // namespace Ramulator
 
@@ -0,0 +1,68 @@
+#ifndef RAMULATOR_DRAM_POWER_TRACE_H
+#define RAMULATOR_DRAM_POWER_TRACE_H
+
+#include <string>
+#include <fstream>
+#include <filesystem>
+#include <cstdint>
+
+#include "base/type.h"
+#include "base/exception.h"
+
+namespace Ramulator {
+
+/**
+ * @brief     Writes the energy of each rank over fixed intervals of cycles.
+ * @details
+ * Each sample is one row of "cycle,rank,background_energy,cmd_energy,refresh_energy" (nJ) in CSV, or one
+ * packed record of {uint64 cycle, uint32 rank, double background, double cmd, double refresh} in binary.
+ * The cycle is the end of the interval. The command energy does not include the refresh energy.
+ *
+ */
+class PowerTrace {
+  private:
+    std::ofstream m_output;
+    bool m_is_binary = false;
+
+  public:
+    void open(const std::filesystem::path& path, const std::string& format) {
+      if (format == "binary") {
+        m_is_binary = true;
+      } else if (format != "csv") {
+        throw ConfigurationError("Unrecognized power trace format \"{}\" (expected csv or binary)!", format);
+      }
+
+      if (path.has_parent_path()) {
+        std::filesystem::create_directories(path.parent_path());
+      }
+      m_output.open(path, m_is_binary ? std::ios::binary : std::ios::out);
+      if (!m_output.is_open()) {
+        throw ConfigurationError("Cannot open power trace file {}!", path.string());
+      }
+      if (!m_is_binary) {
+        m_output << "cycle,rank,background_energy,cmd_energy,refresh_energy\n";
+      }
+    };
+
+    bool is_open() const { return m_output.is_open(); };
+
+    void write(Clk_t clk, int rank_id, double background_energy, double cmd_energy, double refresh_energy) {
+      if (m_is_binary) {
+        uint64_t cycle = clk;
+        uint32_t rank = rank_id;
+        m_output.write(reinterpret_cast<const char*>(&cycle), sizeof(cycle));
+        m_output.write(reinterpret_cast<const char*>(&rank), sizeof(rank));
+        m_output.write(reinterpret_cast<const char*>(&background_energy), sizeof(background_energy));
+        m_output.write(reinterpret_cast<const char*>(&cmd_energy), sizeof(cmd_energy));
+        m_output.write(reinterpret_cast<const char*>(&refresh_energy), sizeof(refresh_energy));
+      } else {
+        m_output << fmt::format("{},{},{},{},{}\n", clk, rank_id, background_energy, cmd_energy, refresh_energy);
+      }
+    };
+
+    void close() { m_output.close(); };
+};
+
+}        // namespace Ramulator
+
+#endif   // RAMULATOR_DRAM_POWER_TRACE_H
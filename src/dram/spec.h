@@ -300,24 +300,88 @@ struct PowerStats {
     enum class PowerState {
       IDLE = 0,
       ACTIVE = 1,
-      REFRESHING = 2
+      REFRESHING = 2,
+      POWER_DOWN = 3,
+      SELF_REFRESH = 4
     };
     PowerState cur_power_state = PowerState::IDLE;
+    PowerState pre_powerdown_state = PowerState::IDLE;   // The state to return to on power-down exit
 
     double act_background_energy = 0;
     double pre_background_energy = 0;
+    double powerdown_background_energy = 0;
+    double selfrefresh_energy = 0;
+    double powerdown_energy_saved = 0;    // Standby energy of the power-down and self-refresh cycles minus their actual energy
 
     double total_background_energy = 0;
     double total_cmd_energy = 0;
     double total_energy = 0;
 
     std::vector<size_t> cmd_counters;
+    int num_open_banks = 0;         // Tracked by the power lambdas (see Lambdas::Power::Rank::get_open_bank_count())
+    int num_refreshing_banks = 0;   // Tracked by the power lambdas (see Lambdas::Power::Rank::get_refreshing_bank_count())
 
     Clk_t active_cycles = 0;
     Clk_t idle_cycles = 0;
 
+    Clk_t active_powerdown_cycles = 0;
+    Clk_t precharge_powerdown_cycles = 0;
+    Clk_t selfrefresh_cycles = 0;
+
     Clk_t active_start_cycle = -1; // initially rank is not active
     Clk_t idle_start_cycle = 0;
+    Clk_t powerdown_start_cycle = -1;
+
+    /**
+     * @brief    The cycles spent in each power state and the command counts of a rank.
+     * 
+     */
+    struct Residency {
+      Clk_t active_cycles = 0;
+      Clk_t idle_cycles = 0;
+      Clk_t active_powerdown_cycles = 0;
+      Clk_t precharge_powerdown_cycles = 0;
+      Clk_t selfrefresh_cycles = 0;
+      std::vector<size_t> cmd_counters;
+
+      Residency operator-(const Residency& other) const {
+        Residency diff = *this;
+        diff.active_cycles -= other.active_cycles;
+        diff.idle_cycles -= other.idle_cycles;
+        diff.active_powerdown_cycles -= other.active_powerdown_cycles;
+        diff.precharge_powerdown_cycles -= other.precharge_powerdown_cycles;
+        diff.selfrefresh_cycles -= other.selfrefresh_cycles;
+        for (size_t i = 0; i < diff.cmd_counters.size() && i < other.cmd_counters.size(); i++) {
+          diff.cmd_counters[i] -= other.cmd_counters[i];
+        }
+        return diff;
+      };
+    };
+
+    /**
+     * @brief    Returns the residency of the rank up to clk, including the time spent so far in the current state.
+     * @details
+     * Only the counters of the rank are read, so the residency can be sampled at any cycle in O(1).
+     * 
+     */
+    Residency get_residency(Clk_t clk) const {
+      Residency residency {active_cycles, idle_cycles, active_powerdown_cycles, precharge_powerdown_cycles, selfrefresh_cycles, cmd_counters};
+      switch (cur_power_state) {
+        case PowerState::IDLE:         residency.idle_cycles += clk - idle_start_cycle; break;
+        case PowerState::ACTIVE:       residency.active_cycles += clk - active_start_cycle; break;
+        case PowerState::REFRESHING:   break;   // Accounted for by the refresh command energy
+        case PowerState::POWER_DOWN: {
+          if (pre_powerdown_state == PowerState::ACTIVE) {
+            residency.active_powerdown_cycles += clk - powerdown_start_cycle;
+          } else {
+            residency.precharge_powerdown_cycles += clk - powerdown_start_cycle;
+          }
+          break;
+        }
+        case PowerState::SELF_REFRESH: residency.selfrefresh_cycles += clk - powerdown_start_cycle; break;
+      }
+      return residency;
+    };
     
 };        
 
@@ -0,0 +1,241 @@
+#ifndef RAMULATOR_DRAM_TIMING_H
+#define RAMULATOR_DRAM_TIMING_H
+
+#include <vector>
+#include <array>
+#include <bit>
+#include <limits>
+#include <algorithm>
+
+#include "base/type.h"
+#include "dram/spec.h"
+
+namespace Ramulator {
+
+/**
+ * @brief     Timing states (command ready cycles and issue histories) of all nodes in a channel.
+ * @details
+ * Instead of every node keeping its own vectors, the states of all nodes at a level are stored in 
+ * contiguous arrays indexed by the flat id of the node within the channel (i.e., the flat id of a 
+ * child is parent_flat_id * num_children + child_id). The walks over the levels are unrolled at 
+ * compile time, since the number of levels with nodes is known from the spec of the standard.
+ * The sibling constraints of a command are recorded once at the parent of its target node instead
+ * of at every sibling, so that issuing a command only walks the path to its target.
+ * 
+ */
+template<typename T>
+class DRAMTimingState {
+  public:
+    static constexpr int m_num_levels = T::m_levels["row"];   // Levels that have nodes (the rows and below do not)
+    static constexpr int m_num_cmds = T::m_commands.size();
+
+  private:
+    std::array<int, m_num_levels> m_level_sizes {};  // Number of children per node of the previous level 
+
+    std::array<std::vector<Clk_t>, m_num_levels> m_cmd_ready_clk;   // The next cycle that each command can be issued again, [node][cmd]
+
+    // The ready cycle set on the children of a node by the sibling constraints. A child is only constrained by the 
+    // commands issued to its siblings, so the latest ready cycle set by any child is kept together with the latest 
+    // one set by all the other children.
+    struct SiblingReadyClk {
+      Clk_t ready_clk = -1;         // The latest ready cycle set by a command issued to any child
+      int child_id = -1;            // The child that ready_clk was set by
+      Clk_t other_ready_clk = -1;   // The latest ready cycle set by a command issued to any other child
+    };
+    std::array<std::vector<SiblingReadyClk>, m_num_levels> m_sibling_ready_clk;   // For the nodes of each level, [parent][cmd]
+
+    std::array<std::array<int, m_num_cmds>, m_num_levels> m_history_offsets {};   // Offset of the issue-history of each command within a node
+    std::array<std::array<int, m_num_cmds>, m_num_levels> m_history_windows {};   // Length of the issue-history of each command
+    std::array<std::array<int, m_num_cmds>, m_num_levels> m_history_masks {};     // Capacity (a power of two) - 1 of the issue-history of each command
+    std::array<int, m_num_levels> m_history_sizes {};                             // Length of the issue-histories of a node
+    std::array<std::vector<Clk_t>, m_num_levels> m_cmd_history;                   // Ring buffer of the issue-history of each command, [node][offset + i]
+    std::array<std::vector<int>, m_num_levels> m_history_heads;                   // Position of the most recent issue in each ring buffer, [node][cmd]
+
+    std::array<std::array<std::vector<TimingConsEntry>, m_num_cmds>, m_num_levels> m_target_cons;    // Timing constraints on the target nodes
+    std::array<std::array<std::vector<TimingConsEntry>, m_num_cmds>, m_num_levels> m_sibling_cons;   // Timing constraints on the siblings of the target nodes
+
+  public:
+    DRAMTimingState(const T* spec) {
+      int num_nodes = 1;
+      for (int level = 0; level < m_num_levels; level++) {
+        if (level > 0) {
+          m_level_sizes[level] = std::max(spec->m_organization.count[level], 0);
+          m_sibling_ready_clk[level].resize(num_nodes * m_num_cmds);
+          num_nodes *= m_level_sizes[level];
+        }
+
+        int history_size = 0;
+        for (int cmd = 0; cmd < m_num_cmds; cmd++) {
+          int window = 0;
+          for (const auto& t : spec->m_timing_cons[level][cmd]) {
+            window = std::max(window, t.window);
+            if (t.sibling) {
+              m_sibling_cons[level][cmd].push_back(t);
+            } else {
+              m_target_cons[level][cmd].push_back(t);
+            }
+          }
+          int capacity = window ? std::bit_ceil(static_cast<unsigned>(window)) : 0;
+          m_history_offsets[level][cmd] = history_size;
+          m_history_windows[level][cmd] = window;
+          m_history_masks[level][cmd] = capacity - 1;
+          history_size += capacity;
+        }
+        m_history_sizes[level] = history_size;
+
+        m_cmd_ready_clk[level].resize(num_nodes * m_num_cmds, -1);
+        m_cmd_history[level].resize(num_nodes * history_size, -1);
+        m_history_heads[level].resize(num_nodes * m_num_cmds, 0);
+      }
+    };
+
+    /**
+     * @brief     Updates the timing states of the channel after a command is issued to addr_vec.
+     * 
+     */
+    void update_timing(int command, const AddrVec_t& addr_vec, Clk_t clk) {
+      update_timing<0>(0, command, addr_vec, clk);
+    };
+
+    /**
+     * @brief     Checks the ready cycles of all nodes on the path of the command. 
+     * 
+     */
+    bool check_ready(int command, const AddrVec_t& addr_vec, Clk_t clk) const {
+      return get_ready_clk<0>(0, 0, command, addr_vec, clk) != NOT_READY;
+    };
+
+    /**
+     * @brief     Returns the earliest cycle allowed by the ready cycles of all nodes on the path of the command.
+     * 
+     */
+    Clk_t get_ready_clk(int command, const AddrVec_t& addr_vec) const {
+      return get_ready_clk<0>(0, 0, command, addr_vec, NOT_READY);
+    };
+
+  private:
+    // Stops the walk of get_ready_clk as soon as a node is not ready at the given cycle
+    static constexpr Clk_t NOT_READY = std::numeric_limits<Clk_t>::max();
+
+    static void add_sibling_ready_clk(SiblingReadyClk& sibling_ready_clk, int child_id, Clk_t ready_clk) {
+      if (child_id == sibling_ready_clk.child_id) {
+        sibling_ready_clk.ready_clk = std::max(sibling_ready_clk.ready_clk, ready_clk);
+      } else if (ready_clk > sibling_ready_clk.ready_clk) {
+        sibling_ready_clk.other_ready_clk = sibling_ready_clk.ready_clk;
+        sibling_ready_clk.ready_clk = ready_clk;
+        sibling_ready_clk.child_id = child_id;
+      } else {
+        sibling_ready_clk.other_ready_clk = std::max(sibling_ready_clk.other_ready_clk, ready_clk);
+      }
+    };
+
+    static Clk_t get_sibling_ready_clk(const SiblingReadyClk& sibling_ready_clk, int child_id) {
+      return child_id == sibling_ready_clk.child_id ? sibling_ready_clk.other_ready_clk : sibling_ready_clk.ready_clk;
+    };
+
+    template<int Level>
+    void update_timing(int node, int command, const AddrVec_t& addr_vec, Clk_t clk) {
+      Clk_t* ready_clk = &m_cmd_ready_clk[Level][node * m_num_cmds];
+
+      /************************************************
+       *          Update Target Node Timing
+       ***********************************************/
+      // Update history
+      int mask = m_history_masks[Level][command];
+      Clk_t* history = &m_cmd_history[Level][node * m_history_sizes[Level] + m_history_offsets[Level][command]];
+      int& head = m_history_heads[Level][node * m_num_cmds + command];
+      if (m_history_windows[Level][command]) {
+        head = (head + 1) & mask;
+        history[head] = clk;
+      }
+
+      for (const auto& t : m_target_cons[Level][command]) {
+        // Get the oldest history
+        Clk_t past = history[(head - (t.window - 1)) & mask];
+        if (past < 0) {
+          // not enough history
+          continue; 
+        }
+
+        // update earliest schedulable time of every command
+        Clk_t future = past + t.val;
+        ready_clk[t.cmd] = std::max(ready_clk[t.cmd], future);
+      }
+
+      if constexpr (Level + 1 < m_num_levels) {
+        int num_children = m_level_sizes[Level + 1];
+        int child_id = addr_vec[Level + 1];
+        if (num_children == 0) {
+          return;
+        }
+
+        if (child_id == -1) {
+          // e.g., an all-bank command, all of my children are targets
+          for (child_id = 0; child_id < num_children; child_id++) {
+            update_timing<Level + 1>(node * num_children + child_id, command, addr_vec, clk);
+          }
+          return;
+        }
+
+        /************************************************
+         *         Update Sibling Node Timing
+         ***********************************************/
+        // Recorded once for all siblings of the target child, see get_ready_clk()
+        SiblingReadyClk* sibling_ready_clk = &m_sibling_ready_clk[Level + 1][node * m_num_cmds];
+        for (const auto& t : m_sibling_cons[Level + 1][command]) {
+          // update earliest schedulable time of every command
+          add_sibling_ready_clk(sibling_ready_clk[t.cmd], child_id, clk + t.val);
+        }
+
+        update_timing<Level + 1>(node * num_children + child_id, command, addr_vec, clk);
+      }
+    };
+
+    /**
+     * @brief     Returns the latest ready cycle on the path, or NOT_READY as soon as it is later than clk.
+     * 
+     */
+    template<int Level>
+    Clk_t get_ready_clk(int parent, int child_id, int command, const AddrVec_t& addr_vec, Clk_t clk) const {
+      int node = Level == 0 ? 0 : parent * m_level_sizes[Level] + child_id;
+      Clk_t ready_clk = m_cmd_ready_clk[Level][node * m_num_cmds + command];
+      if constexpr (Level > 0) {
+        // combine with the ready cycle set by the commands issued to my siblings
+        ready_clk = std::max(ready_clk, get_sibling_ready_clk(m_sibling_ready_clk[Level][parent * m_num_cmds + command], child_id));
+      }
+      if (ready_clk != -1 && clk < ready_clk) {
+        // stop the walk: the check failed at this level
+        return NOT_READY;
+      }
+
+      if constexpr (Level + 1 < m_num_levels) {
+        int num_children = m_level_sizes[Level + 1];
+        if (Level == T::m_command_scopes[command] || num_children == 0) {
+          // stop the walk: checked all levels
+          return ready_clk;
+        }
+
+        int child_id = addr_vec[Level + 1];
+        if (child_id == -1) {
+          // e.g., a same-bank command, check all children
+          for (child_id = 0; child_id < num_children; child_id++) {
+            Clk_t child_ready_clk = get_ready_clk<Level + 1>(node, child_id, command, addr_vec, clk);
+            if (child_ready_clk == NOT_READY) {
+              return NOT_READY;
+            }
+            ready_clk = std::max(ready_clk, child_ready_clk);
+          }
+          return ready_clk;
+        } else {
+          Clk_t child_ready_clk = get_ready_clk<Level + 1>(node, child_id, command, addr_vec, clk);
+          return child_ready_clk == NOT_READY ? NOT_READY : std::max(ready_clk, child_ready_clk);
+        }
+      } else {
+        return ready_clk;
+      }
+    };
+};
+
+}        // namespace Ramulator
+
+#endif   // RAMULATOR_DRAM_TIMING_H
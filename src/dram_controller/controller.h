@@ -28,6 +28,10 @@ class IDRAMController : public Clocked<IDRAMController> {
     std::vector<IControllerPlugin*> m_plugins;
 
     int m_channel_id = -1;
+
+  protected:
+    std::vector<Request>* m_deferred_callbacks = nullptr;   // If set, served requests are held here instead of being called back
+
   public:
     /**
      * @brief       Send a request to the memory controller.
@@ -53,10 +57,41 @@ class IDRAMController : public Clocked<IDRAMController> {
     virtual size_t get_read_queue_length() = 0;
     virtual size_t get_write_queue_length() = 0;
     virtual size_t get_active_buffer_length() = 0;
+    virtual size_t get_priority_queue_length() = 0;
+
+    virtual bool is_req_in_read_queue(const Request& req) = 0;
+    virtual bool is_req_in_pending_queue(const Request& req) = 0;
+
+    /**
+     * @brief       Whether any buffered request would hit the open row of the bank at addr_vec.
+     * @details
+     * Used by refresh managers to postpone the refreshes of the banks that are being accessed.
+     */
+    virtual bool has_pending_row_hits(const AddrVec_t& addr_vec) { return false; };
 
-    virtual bool is_req_in_read_queue(Request req) = 0;
-    virtual bool is_req_in_pending_queue(Request req) = 0;
-   
+    /**
+     * @brief       Hold served requests in the given queue instead of calling them back.
+     * @details
+     * Used by memory systems that tick controllers off the main thread. The memory system then
+     * calls back the requests in the queue itself.
+     */
+    void defer_callbacks(std::vector<Request>* queue) { m_deferred_callbacks = queue; };
+
+  protected:
+    /**
+     * @brief       Calls back the frontend (if any) that sent the request.
+     * 
+     */
+    void call_back(Request& req) {
+      if (!req.callback) {
+        return;
+      }
+      if (m_deferred_callbacks) {
+        m_deferred_callbacks->push_back(req);
+      } else {
+        req.callback(req);
+      }
+    };
 };
 
 }       // namespace Ramulator
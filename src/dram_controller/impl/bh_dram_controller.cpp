@@ -189,8 +189,12 @@ class BHDRAMController final : public IBHDRAMController, public Implementation {
       return m_active_buffer.size(); 
     };
 
-    bool is_req_in_read_queue(Request req) override {return true;};
-    bool is_req_in_pending_queue(Request req) override {return true;};
+    size_t get_priority_queue_length() override {
+      return m_priority_buffer.size(); 
+    };
+
+    bool is_req_in_read_queue(const Request& req) override {return true;};
+    bool is_req_in_pending_queue(const Request& req) override {return true;};
 
   private:
     /**
@@ -213,7 +217,7 @@ class BHDRAMController final : public IBHDRAMController, public Implementation {
 
           if (req.callback) {
             // If the request comes from outside (e.g., processor), call its callback
-            req.callback(req);
+            call_back(req);
           }
           // Finally, remove this request from the pending queue
           pending.pop_front();
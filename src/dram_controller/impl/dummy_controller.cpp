@@ -12,14 +12,14 @@ class DummyController final : public IDRAMController, public Implementation {
 
     bool send(Request& req) override {
       if (req.callback) {
-        req.callback(req);
+        call_back(req);
       }
       return true; 
     };
 
     bool priority_send(Request& req) override {
       if (req.callback) {
-        req.callback(req);
+        call_back(req);
       }
       return true; 
     };
@@ -37,9 +37,12 @@ class DummyController final : public IDRAMController, public Implementation {
     size_t get_active_buffer_length() override {
       return 0; 
     };
+    size_t get_priority_queue_length() override {
+      return 0; 
+    };
 
-    bool is_req_in_read_queue(Request req) override {return true;};
-    bool is_req_in_pending_queue(Request req) override {return true;};
+    bool is_req_in_read_queue(const Request& req) override {return true;};
+    bool is_req_in_pending_queue(const Request& req) override {return true;};
 
 };
 
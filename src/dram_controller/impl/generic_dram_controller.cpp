@@ -1,3 +1,4 @@
+#include "base/histogram.h"
 #include "dram_controller/controller.h"
 #include "memory_system/memory_system.h"
 
@@ -15,6 +16,11 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
 
     int m_bank_addr_idx = -1;
 
+    // The earliest cycle at which a buffered request can be issued, valid while the channel states do not change
+    Clk_t m_next_ready_cycle = -1;
+    uint64_t m_next_ready_epoch = 0;
+    Clk_t m_last_issue_clk = -1;
+
     float m_wr_low_watermark;
     float m_wr_high_watermark;
     bool  m_is_write_mode = false;
@@ -72,6 +78,16 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
     int64_t s_num_queue_points_stream = 0;
     int64_t s_num_queue_points_random = 0;
 
+    // Distributions of the read latency (arrive -> depart) and queueing time (enqueued -> dequeued)
+    LatencyHistogram s_read_latency_hist;
+    LatencyHistogram s_read_latency_hist_random;
+    LatencyHistogram s_read_latency_hist_stream;
+    std::vector<LatencyHistogram> s_read_latency_hist_per_core;
+    LatencyHistogram s_queue_time_hist;
+    LatencyHistogram s_queue_time_hist_random;
+    LatencyHistogram s_queue_time_hist_stream;
+    std::vector<LatencyHistogram> s_queue_time_hist_per_core;
+
   public:
 
     size_t get_read_queue_length() override {
@@ -86,24 +102,49 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
       return m_active_buffer.size(); 
     };
 
-    bool contains(const Request &req, ReqBuffer buffer) const {
+    size_t get_priority_queue_length() override {
+      return m_priority_buffer.size(); 
+    };
+
+    bool contains(const Request &req, ReqBuffer& buffer) const {
       return std::find_if(buffer.begin(), buffer.end(), [&](const Request &r) {
           return r.addr == req.addr; }) != buffer.end();
     }
 
-    bool is_req_in_read_queue(Request req) override {
+    bool is_req_in_read_queue(const Request& req) override {
       if (contains(req, m_read_buffer)) return true;
       return false;
     }
 
-    bool is_req_in_pending_queue(Request req) override {
+    bool is_req_in_pending_queue(const Request& req) override {
       if (contains(req, m_active_buffer)) return true;
       return false;
     }
+
+    bool has_pending_row_hits(const AddrVec_t& addr_vec) override {
+      bool has_row_hits = false;
+      for (auto buffer : {&m_active_buffer, &m_read_buffer, &m_write_buffer}) {
+        int bank_id = buffer->get_bank_id(addr_vec);
+        if (bank_id == -1 || buffer->get_bank_size(bank_id) == 0) {
+          continue;
+        }
+        // All requests of a row group hit the same row, only the oldest one is checked
+        buffer->for_each_group_head_in_bank(bank_id, [&](ReqBuffer::iterator head, ReqBuffer::GroupCache&) {
+          has_row_hits = has_row_hits || is_row_hit(head);
+        });
+        if (has_row_hits) {
+          return true;
+        }
+      }
+      return false;
+    }
   
     void init() override {
       m_wr_low_watermark =  param<float>("wr_low_watermark").desc("Threshold for switching back to read mode.").default_val(0.2f);
       m_wr_high_watermark = param<float>("wr_high_watermark").desc("Threshold for switching to write mode.").default_val(0.8f);
+      int queue_size = param<int>("queue_size").desc("Capacity of the read and write request buffers.").default_val(32);
+      m_read_buffer.max_size = queue_size;
+      m_write_buffer.max_size = queue_size;
 
       m_scheduler = create_child_ifce<IScheduler>();
       m_refresh = create_child_ifce<IRefreshManager>();    
@@ -120,6 +161,13 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
     void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
       m_dram = memory_system->get_ifce<IDRAM>();
       m_bank_addr_idx = m_dram->m_levels("bank");
+
+      // Index the request buffers by bank and row, so that the scheduler only needs to look at one request per row
+      // and conflicts with the active buffer can be checked per bank
+      int row_addr_idx = m_dram->m_levels("row");
+      for (auto buffer : {&m_active_buffer, &m_read_buffer, &m_write_buffer}) {
+        buffer->enable_bank_index(m_bank_addr_idx, row_addr_idx, m_dram->m_organization.count);
+      }
       m_priority_buffer.max_size = 512*3 + 32;
 
       m_num_cores = frontend->get_num_cores();
@@ -127,6 +175,8 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
       s_read_row_hits_per_core.resize(m_num_cores, 0);
       s_read_row_misses_per_core.resize(m_num_cores, 0);
       s_read_row_conflicts_per_core.resize(m_num_cores, 0);
+      s_read_latency_hist_per_core.resize(m_num_cores);
+      s_queue_time_hist_per_core.resize(m_num_cores);
 
       register_stat(s_row_hits).name("row_hits_{}", m_channel_id);
       register_stat(s_row_misses).name("row_misses_{}", m_channel_id);
@@ -168,6 +218,17 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
 
       register_stat(s_avg_strided_read_latency).name("average_strided_read_latency_{}", m_channel_id);
       register_stat(s_avg_random_read_latency).name("avg_random_read_latency_{}", m_channel_id);
+
+      register_stat(s_read_latency_hist).name("read_latency_hist_{}", m_channel_id);
+      register_stat(s_read_latency_hist_random).name("read_latency_hist_random_{}", m_channel_id);
+      register_stat(s_read_latency_hist_stream).name("read_latency_hist_stream_{}", m_channel_id);
+      register_stat(s_queue_time_hist).name("queue_time_hist_{}", m_channel_id);
+      register_stat(s_queue_time_hist_random).name("queue_time_hist_random_{}", m_channel_id);
+      register_stat(s_queue_time_hist_stream).name("queue_time_hist_stream_{}", m_channel_id);
+      for (size_t core_id = 0; core_id < m_num_cores; core_id++) {
+        register_stat(s_read_latency_hist_per_core[core_id]).name("read_latency_hist_core_{}", core_id);
+        register_stat(s_queue_time_hist_per_core[core_id]).name("queue_time_hist_core_{}", core_id);
+      }
     };
 
     bool send(Request& req) override {
@@ -217,6 +278,7 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
         req.arrive = -1;
         return false;
       }
+      update_next_ready_cycle(req);
 
       if (is_success) {
         switch (req.type_id) {
@@ -248,13 +310,31 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
 
       bool is_success = false;
       is_success = m_priority_buffer.enqueue(req);
+      if (is_success) {
+        update_next_ready_cycle(req);
+      }
       return is_success;
     }
 
+    void record_distribution(LatencyHistogram& all, LatencyHistogram& random, LatencyHistogram& stream,
+                             std::vector<LatencyHistogram>& per_core, const Request& req, int64_t val) {
+      all.record(val);
+      if (req.request_type == 0) {
+        random.record(val);
+      } else if (req.request_type == 1) {
+        stream.record(val);
+      }
+      if (req.source_id >= 0 && req.source_id < static_cast<int>(per_core.size())) {
+        per_core[req.source_id].record(val);
+      }
+    }
+
     void update_queue_stay_stats(ReqBuffer::iterator req) {
       if (req->enqueued == -1 || req->dequeued == -1) {
         return;
       }
+      record_distribution(s_queue_time_hist, s_queue_time_hist_random, s_queue_time_hist_stream,
+                          s_queue_time_hist_per_core, *req, req->dequeued - req->enqueued);
       if (req->request_type == 0) {
         int64_t val = (req->dequeued - req->enqueued);
         s_queue_time_random += val;
@@ -292,6 +372,7 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
 
       // 2.1 Take row policy action
       m_rowpolicy->update(request_found, req_it);
+      m_scheduler->update(request_found, req_it);
 
       // 3. Update all plugins
       for (auto plugin : m_plugins) {
@@ -305,6 +386,7 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
           update_request_stats(req_it);
         }
         m_dram->issue_command(req_it->command, req_it->addr_vec);
+        m_last_issue_clk = m_clk;
 
         // If we are issuing the last command, set depart clock cycle and move the request to the pending queue
         if (req_it->command == req_it->final_command) {
@@ -331,8 +413,108 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
 
     };
 
+    Clk_t get_next_event_cycle() override {
+      // We are only waiting for the next refresh, a plugin event, the next completed read, or a buffered request to become ready
+      Clk_t next_event_cycle = m_refresh->get_next_event_cycle();
+      for (auto plugin : m_plugins) {
+        Clk_t plugin_event_cycle = plugin->get_next_event_cycle();
+        if (plugin_event_cycle <= m_clk) {
+          // The plugin may do something at any cycle
+          return m_clk + 1;
+        }
+        next_event_cycle = std::min(next_event_cycle, plugin_event_cycle);
+      }
+      if (pending.size()) {
+        next_event_cycle = std::min(next_event_cycle, std::max(pending[0].depart, m_clk + 1));
+      }
+      if (m_active_buffer.size() || m_priority_buffer.size() || m_read_buffer.size() || m_write_buffer.size()) {
+        if (m_last_issue_clk == m_clk) {
+          // We are likely to issue again soon, do not bother looking ahead
+          return m_clk + 1;
+        }
+        next_event_cycle = std::min(next_event_cycle, std::max(get_next_ready_cycle(), m_clk + 1));
+      }
+      return next_event_cycle;
+    };
+
+    void fast_forward(Clk_t num_cycles) override {
+      if (num_cycles <= 0) {
+        return;
+      }
+      m_clk += num_cycles;
+
+      // Same statistics as num_cycles ticks that do not issue any command
+      s_queue_len += (m_read_buffer.size() + m_write_buffer.size() + m_priority_buffer.size() + pending.size()) * num_cycles;
+      s_read_queue_len += (m_read_buffer.size() + pending.size()) * num_cycles;
+      s_write_queue_len += m_write_buffer.size() * num_cycles;
+      s_priority_queue_len += m_priority_buffer.size() * num_cycles;
+
+      // An idle tick queries the write policy (which settles after the first query) unless the head of the priority buffer blocks it
+      if (m_priority_buffer.size() == 0) {
+        set_write_mode();
+      }
+
+      m_refresh->fast_forward(num_cycles);
+      for (auto plugin : m_plugins) {
+        plugin->fast_forward(num_cycles);
+      }
+    };
+
 
   private:
+    /**
+     * @brief    Returns the earliest cycle at which any buffered request can be issued.
+     * @details
+     * Nothing is issued before this cycle unless the states of the channel change (i.e., by a future action 
+     * of the device or a newly buffered request), so the ticks before it can be skipped.
+     * 
+     */
+    Clk_t get_next_ready_cycle() {
+      uint64_t epoch = m_dram->get_state_epoch(m_channel_id);
+      if (m_next_ready_cycle != -1 && epoch == m_next_ready_epoch) {
+        return m_next_ready_cycle;
+      }
+
+      Clk_t next_ready_cycle = NEVER_CLK;
+      auto update = [&](const Request& req) {
+        int command = m_dram->get_preq_command(req.final_command, req.addr_vec);
+        next_ready_cycle = std::min(next_ready_cycle, m_dram->get_ready_clk(command, req.addr_vec));
+      };
+      // All requests of a row group have the same prerequisite command, only the oldest one is checked
+      auto update_groups = [&](ReqBuffer& buffer) {
+        buffer.for_each_group_head([&](ReqBuffer::iterator head, ReqBuffer::GroupCache&) {
+          update(*head);
+        });
+      };
+      update_groups(m_active_buffer);
+      if (m_priority_buffer.size()) {
+        // Requests in the priority buffer are served in order and block the other buffers
+        update(*m_priority_buffer.begin());
+      } else {
+        // The write mode may change when it is queried next, so both buffers are considered
+        update_groups(m_read_buffer);
+        update_groups(m_write_buffer);
+      }
+
+      m_next_ready_cycle = next_ready_cycle;
+      m_next_ready_epoch = epoch;
+      return next_ready_cycle;
+    }
+
+    /**
+     * @brief    Keeps the cached earliest ready cycle up to date with a newly buffered request.
+     * @details
+     * Requests only leave the buffers when a command is issued, which changes the states of the channel anyway.
+     * 
+     */
+    void update_next_ready_cycle(const Request& req) {
+      if (m_next_ready_cycle == -1 || m_dram->get_state_epoch(m_channel_id) != m_next_ready_epoch) {
+        return;
+      }
+      int command = m_dram->get_preq_command(req.final_command, req.addr_vec);
+      m_next_ready_cycle = std::min(m_next_ready_cycle, m_dram->get_ready_clk(command, req.addr_vec));
+    }
+
     /**
      * @brief    Helper function to check if a request is hitting an open row
      * @details
@@ -412,6 +594,8 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
             // Check if this requests accesses the DRAM or is being forwarded.
             // TODO add the stats back
             s_read_latency += req.depart - req.arrive;
+            record_distribution(s_read_latency_hist, s_read_latency_hist_random, s_read_latency_hist_stream,
+                                s_read_latency_hist_per_core, req, req.depart - req.arrive);
             if (req.request_type == 0) {
               s_random_read_latency += req.depart - req.arrive;
             } else if (req.request_type == 1) {
@@ -421,7 +605,7 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
 
           if (req.callback) {
             // If the request comes from outside (e.g., processor), call its callback
-            req.callback(req);
+            call_back(req);
           }
           // Finally, remove this request from the pending queue
           pending.pop_front();
@@ -447,6 +631,24 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
     };
 
 
+    /**
+     * @brief    Drops the requests at the head of the priority buffer that the plugins that sent them no longer want.
+     * 
+     */
+    void drop_withdrawn_priority_requests() {
+      while (m_priority_buffer.size() != 0) {
+        auto req_it = m_priority_buffer.begin();
+        bool is_withdrawn = false;
+        for (auto plugin : m_plugins) {
+          is_withdrawn |= plugin->is_withdrawn(*req_it);
+        }
+        if (!is_withdrawn) {
+          return;
+        }
+        m_priority_buffer.remove(req_it);
+      }
+    }
+
     /**
      * @brief    Helper function to find a request to schedule from the buffers.
      * 
@@ -464,6 +666,7 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
       // 2.2    If no requests can be scheduled from the act buffer, check the rest of the buffers
       if (!request_found) {
         // 2.2.1    We first check the priority buffer to prioritize e.g., maintenance requests
+        drop_withdrawn_priority_requests();
         if (m_priority_buffer.size() != 0) {
           req_buffer = &m_priority_buffer;
           req_it = m_priority_buffer.begin();
@@ -490,6 +693,12 @@ class GenericDRAMController final : public IDRAMController, public Implementatio
       // 2.3 If we find a request to schedule, we need to check if it will close an opened row in the active buffer.
       if (request_found) {
         if (m_dram->m_command_meta(req_it->command).is_closing) {
+          int bank_id = m_active_buffer.get_bank_id(req_it->addr_vec);
+          if (bank_id != -1 && m_active_buffer.get_bank_size(-1) == 0) {
+            // Every request in the active buffer targets a single bank, only the ones in the same bank can conflict
+            return m_active_buffer.get_bank_size(bank_id) == 0;
+          }
+
           auto& rowgroup = req_it->addr_vec;
           for (auto _it = m_active_buffer.begin(); _it != m_active_buffer.end(); _it++) {
             auto& _it_rowgroup = _it->addr_vec;
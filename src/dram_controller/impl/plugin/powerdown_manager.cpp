@@ -0,0 +1,221 @@
+#include <vector>
+
+#include "base/base.h"
+#include "dram_controller/controller.h"
+#include "dram_controller/plugin.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    Puts idle ranks into power-down and self-refresh.
+ * @details
+ * A rank enters power-down when no command has been issued to it for powerdown_timeout cycles, and
+ * self-refresh after selfrefresh_timeout cycles, while the read, write, and active buffers of the
+ * controller are empty. A power-down or self-refresh entry that is still queued when a request arrives
+ * is dropped. The rank is woken up (PDX/SRX) by the next command to it. The energy saved is reported by
+ * the DRAM (with drampower_enable). The wake-up latency is reported here per exit: it is the time the
+ * request that causes the exit waits for the rank (from its arrival to the end of the exit latency).
+ * Requests queued behind that request also wait for the exit, but are not counted.
+ *
+ */
+class PowerDownManager : public IControllerPlugin, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IControllerPlugin, PowerDownManager, "PowerDownManager", "Idle-timeout power-down and self-refresh entry.")
+
+  private:
+    enum class RankState { Awake, PowerDown, SelfRefresh };
+
+    struct Rank {
+      RankState state = RankState::Awake;
+      Clk_t last_active_clk = 0;    // The last cycle a command (other than power-down/self-refresh entry or exit) was issued to the rank
+      Clk_t sleep_start_clk = -1;   // The cycle the rank entered power-down or self-refresh
+      bool is_pending = false;      // Whether a power-down or self-refresh request is waiting to be issued
+    };
+
+    IDRAM* m_dram = nullptr;
+    Clk_t m_clk = 0;
+
+    Clk_t m_powerdown_timeout = -1;
+    Clk_t m_selfrefresh_timeout = -1;
+
+    int m_rank_level = -1;
+    int m_pd_req_id = -1;
+    int m_sr_req_id = -1;
+    int m_pde_cmd_id = -1;
+    int m_pdx_cmd_id = -1;
+    int m_sre_cmd_id = -1;
+    int m_srx_cmd_id = -1;
+    int m_nXP = -1;
+    int m_nXS = -1;
+
+    std::vector<Rank> m_ranks;
+
+    size_t s_num_powerdown_entries = 0;
+    size_t s_num_selfrefresh_entries = 0;
+    size_t s_powerdown_cycles = 0;
+    size_t s_selfrefresh_cycles = 0;
+    size_t s_num_wakeups = 0;
+    size_t s_total_wakeup_latency = 0;
+    float s_avg_wakeup_latency = 0;
+
+  public:
+    void init() override {
+      m_powerdown_timeout = param<Clk_t>("powerdown_timeout").desc("Idle cycles before a rank enters power-down (-1 to disable).").default_val(64);
+      m_selfrefresh_timeout = param<Clk_t>("selfrefresh_timeout").desc("Idle cycles before a rank enters self-refresh (-1 to disable).").default_val(-1);
+    };
+
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      m_ctrl = cast_parent<IDRAMController>();
+      m_dram = m_ctrl->m_dram;
+
+      if (!m_dram->m_requests.contains("power-down") || !m_dram->m_requests.contains("self-refresh")) {
+        throw ConfigurationError("PowerDownManager requires a DRAM with power-down and self-refresh requests, {} has none!", m_dram->get_name());
+      }
+      m_pd_req_id = m_dram->m_requests("power-down");
+      m_sr_req_id = m_dram->m_requests("self-refresh");
+      m_pde_cmd_id = m_dram->m_commands("PDE");
+      m_pdx_cmd_id = m_dram->m_commands("PDX");
+      m_sre_cmd_id = m_dram->m_commands("SRE");
+      m_srx_cmd_id = m_dram->m_commands("SRX");
+      m_nXP = m_dram->m_timing_vals("nXP");
+      m_nXS = m_dram->m_timing_vals("nXS");
+
+      m_rank_level = m_dram->m_levels("rank");
+      m_ranks.resize(m_dram->get_level_size("rank"));
+
+      register_stat(s_num_powerdown_entries).name("num_powerdown_entries_{}", m_ctrl->m_channel_id);
+      register_stat(s_num_selfrefresh_entries).name("num_selfrefresh_entries_{}", m_ctrl->m_channel_id);
+      register_stat(s_powerdown_cycles).name("powerdown_cycles_{}", m_ctrl->m_channel_id);
+      register_stat(s_selfrefresh_cycles).name("selfrefresh_cycles_{}", m_ctrl->m_channel_id);
+      register_stat(s_num_wakeups).name("num_wakeups_{}", m_ctrl->m_channel_id);
+      register_stat(s_total_wakeup_latency).name("total_wakeup_latency_{}", m_ctrl->m_channel_id);
+      register_stat(s_avg_wakeup_latency).name("avg_wakeup_latency_{}", m_ctrl->m_channel_id);
+    };
+
+    void update(bool request_found, ReqBuffer::iterator& req_it) override {
+      m_clk++;
+
+      if (request_found) {
+        observe_command(*req_it);
+      }
+
+      if (!is_idle() || m_ctrl->get_priority_queue_length() != 0) {
+        return;
+      }
+
+      for (int r = 0; r < m_ranks.size(); r++) {
+        Rank& rank = m_ranks[r];
+        if (rank.is_pending || rank.state == RankState::SelfRefresh) {
+          continue;
+        }
+        Clk_t idle_cycles = m_clk - rank.last_active_clk;
+        if (m_selfrefresh_timeout >= 0 && idle_cycles >= m_selfrefresh_timeout) {
+          send(r, m_sr_req_id);
+        } else if (rank.state == RankState::Awake && m_powerdown_timeout >= 0 && idle_cycles >= m_powerdown_timeout) {
+          send(r, m_pd_req_id);
+        }
+      }
+    };
+
+    Clk_t get_next_event_cycle() override {
+      // Nothing is sent until the controller is idle, which only happens after it issues a command
+      if (!is_idle() || m_ctrl->get_priority_queue_length() != 0) {
+        return NEVER_CLK;
+      }
+      Clk_t next_event_cycle = NEVER_CLK;
+      for (const auto& rank : m_ranks) {
+        if (rank.is_pending || rank.state == RankState::SelfRefresh) {
+          continue;
+        }
+        if (m_selfrefresh_timeout >= 0) {
+          next_event_cycle = std::min(next_event_cycle, rank.last_active_clk + m_selfrefresh_timeout);
+        }
+        if (rank.state == RankState::Awake && m_powerdown_timeout >= 0) {
+          next_event_cycle = std::min(next_event_cycle, rank.last_active_clk + m_powerdown_timeout);
+        }
+      }
+      return std::max(next_event_cycle, m_clk + 1);
+    };
+
+    void fast_forward(Clk_t num_cycles) override {
+      m_clk += num_cycles;
+    };
+
+    bool is_withdrawn(const Request& req) override {
+      if (req.type_id != m_pd_req_id && req.type_id != m_sr_req_id) {
+        return false;
+      }
+      // A request arrived after the entry was queued, the rank would be woken up right away
+      if (is_idle()) {
+        return false;
+      }
+      int rank_id = req.addr_vec[m_rank_level];
+      m_ranks[rank_id].is_pending = false;
+      return true;
+    };
+
+    void finalize() override {
+      // Ranks still asleep at the end of the simulation
+      for (auto& rank : m_ranks) {
+        if (rank.state == RankState::PowerDown) {
+          s_powerdown_cycles += m_clk - rank.sleep_start_clk;
+        } else if (rank.state == RankState::SelfRefresh) {
+          s_selfrefresh_cycles += m_clk - rank.sleep_start_clk;
+        }
+      }
+      s_avg_wakeup_latency = s_num_wakeups == 0 ? 0 : (float) s_total_wakeup_latency / (float) s_num_wakeups;
+    };
+
+  private:
+    /**
+     * @brief    Whether the read, write, and active buffers of the controller are empty.
+     * 
+     */
+    bool is_idle() {
+      return m_ctrl->get_read_queue_length() == 0 &&
+             m_ctrl->get_write_queue_length() == 0 &&
+             m_ctrl->get_active_buffer_length() == 0;
+    };
+
+    void observe_command(const Request& req) {
+      int rank_id = req.addr_vec[m_rank_level];
+      if (rank_id < 0) {
+        return;
+      }
+      Rank& rank = m_ranks[rank_id];
+
+      if (req.command == m_pde_cmd_id || req.command == m_sre_cmd_id) {
+        bool is_pd = req.command == m_pde_cmd_id;
+        rank.state = is_pd ? RankState::PowerDown : RankState::SelfRefresh;
+        rank.sleep_start_clk = m_clk;
+        rank.is_pending = false;
+        (is_pd ? s_num_powerdown_entries : s_num_selfrefresh_entries)++;
+      } else if (req.command == m_pdx_cmd_id || req.command == m_srx_cmd_id) {
+        bool is_pd = req.command == m_pdx_cmd_id;
+        (is_pd ? s_powerdown_cycles : s_selfrefresh_cycles) += m_clk - rank.sleep_start_clk;
+        rank.state = RankState::Awake;
+        if (req.type_id == Request::Type::Read || req.type_id == Request::Type::Write) {
+          // The request waited for the wake-up since it arrived, and waits for the exit latency from now on
+          // (only the request that causes the exit is counted, see the class description)
+          s_num_wakeups++;
+          s_total_wakeup_latency += (m_clk - req.arrive) + (is_pd ? m_nXP : m_nXS);
+        }
+      } else if (req.type_id != m_sr_req_id) {
+        // Waking up a rank in power-down to enter self-refresh does not make it active
+        rank.last_active_clk = m_clk;
+      }
+    };
+
+    void send(int rank_id, int req_id) {
+      AddrVec_t addr_vec(m_dram->m_levels.size(), -1);
+      addr_vec[0] = m_ctrl->m_channel_id;
+      addr_vec[m_rank_level] = rank_id;
+      Request req(addr_vec, req_id);
+      if (!m_ctrl->priority_send(req)) {
+        throw std::runtime_error("Failed to send power-down/self-refresh request!");
+      }
+      m_ranks[rank_id].is_pending = true;
+    };
+
+};
+
+}       // namespace Ramulator
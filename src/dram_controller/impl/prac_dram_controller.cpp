@@ -230,9 +230,12 @@ public:
     size_t get_active_buffer_length() override {
         return m_active_buffer.size(); 
     };
+    size_t get_priority_queue_length() override {
+        return m_priority_buffer.size(); 
+    };
 
-    bool is_req_in_read_queue(Request req) override {return true;};
-    bool is_req_in_pending_queue(Request req) override {return true;};
+    bool is_req_in_read_queue(const Request& req) override {return true;};
+    bool is_req_in_pending_queue(const Request& req) override {return true;};
 
 private:
     /**
@@ -255,7 +258,7 @@ private:
 
                 if (req.callback) {
                     // If the request comes from outside (e.g., processor), call its callback
-                    req.callback(req);
+                    call_back(req);
                 }
                 // Finally, remove this request from the pending queue
                 pending.pop_front();
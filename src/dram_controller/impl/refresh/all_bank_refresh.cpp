@@ -18,6 +18,8 @@ class AllBankRefresh : public IRefreshManager, public Implementation {
 
     int m_nrefi = -1;
     int m_ref_req_id = -1;
+    int m_ref_cmd_id = -1;
+    int m_srx_cmd_id = -1;      // The self-refresh exit command, if the DRAM supports self-refresh
     Clk_t m_next_refresh_cycle = -1;
 
   public:
@@ -33,6 +35,10 @@ class AllBankRefresh : public IRefreshManager, public Implementation {
 
       m_nrefi = m_dram->m_timing_vals("nREFI");
       m_ref_req_id = m_dram->m_requests("all-bank-refresh");
+      m_ref_cmd_id = m_dram->m_request_translations(m_ref_req_id);
+      if (m_dram->m_commands.contains("SRX")) {
+        m_srx_cmd_id = m_dram->m_commands("SRX");
+      }
 
       m_next_refresh_cycle = m_nrefi;
     };
@@ -46,6 +52,10 @@ class AllBankRefresh : public IRefreshManager, public Implementation {
           std::vector<int> addr_vec(m_dram_org_levels, -1);
           addr_vec[0] = m_ctrl->m_channel_id;
           addr_vec[1] = r;
+          // A rank in self-refresh refreshes itself
+          if (m_srx_cmd_id != -1 && m_dram->get_preq_command(m_ref_cmd_id, addr_vec) == m_srx_cmd_id) {
+            continue;
+          }
           Request req(addr_vec, m_ref_req_id);
 
           bool is_success = m_ctrl->priority_send(req);
@@ -56,6 +66,14 @@ class AllBankRefresh : public IRefreshManager, public Implementation {
       }
     };
 
+    Clk_t get_next_event_cycle() override {
+      return m_next_refresh_cycle;
+    };
+
+    void fast_forward(Clk_t num_cycles) override {
+      m_clk += num_cycles;
+    };
+
 };
 
 }       // namespace Ramulator
@@ -0,0 +1,236 @@
+#include <vector>
+
+#include "base/base.h"
+#include "dram_controller/controller.h"
+#include "dram_controller/refresh.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    All-bank refresh that postpones refreshes under load and pulls them in when idle.
+ * @details
+ * Every nREFI each rank owes one more refresh. The owed refreshes are postponed while the read queue
+ * holds at least postpone_threshold requests. A rank that owes max_postponed refreshes issues one of
+ * them right away, the rest are paid back one at a time while the read queue is short. When the read,
+ * write, and active buffers of the controller have been empty for pull_in_delay cycles, refreshes are
+ * issued ahead of time (one at a time), up to max_pulled_in of them. The refresh debt of a rank therefore stays within
+ * [-max_pulled_in, max_postponed], and a refresh that is not issued in the nREFI slot in which it becomes due
+ * counts as postponed. A rank in self-refresh refreshes itself and owes nothing, and a rank
+ * in power-down is never woken up for a pulled-in refresh.
+ *
+ */
+class ElasticRefresh : public IRefreshManager, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IRefreshManager, ElasticRefresh, "Elastic", "All-Bank Refresh with postponement and pull-in.")
+  private:
+    Clk_t m_clk = 0;
+    IDRAM* m_dram;
+    IDRAMController* m_ctrl;
+
+    int m_dram_org_levels = -1;
+    int m_rank_level = -1;
+    int m_num_ranks = -1;
+
+    int m_max_postponed = -1;
+    int m_max_pulled_in = -1;
+    int m_postpone_threshold = -1;
+    int m_pull_in_delay = -1;
+
+    int m_nrefi = -1;
+    int m_ref_req_id = -1;
+    int m_ref_cmd_id = -1;
+    int m_pdx_cmd_id = -1;      // The power-down and self-refresh exit commands, if the DRAM supports them
+    int m_srx_cmd_id = -1;
+    Clk_t m_next_refresh_cycle = -1;
+    Clk_t m_idle_start_cycle = -1;  // The cycle since which the controller is idle (-1 if it is not)
+
+    std::vector<int> m_owed;        // The number of refreshes each rank owes (negative if pulled in)
+
+    size_t s_num_refreshes = 0;
+    size_t s_num_postponed = 0;
+    size_t s_num_pulled_in = 0;
+
+  public:
+    void init() override {
+      m_ctrl = cast_parent<IDRAMController>();
+
+      m_max_postponed = param<int>("max_postponed").desc("The maximum number of refreshes a rank can owe.").default_val(4);
+      m_max_pulled_in = param<int>("max_pulled_in").desc("The maximum number of refreshes a rank can be refreshed ahead of time.").default_val(4);
+      m_postpone_threshold = param<int>("postpone_threshold").desc("Refreshes are postponed while the read queue holds at least this many requests.").default_val(16);
+      m_pull_in_delay = param<int>("pull_in_delay").desc("The number of cycles the controller has to be idle before a refresh is pulled in.").default_val(1000);
+
+      if (m_max_postponed < 1) {
+        throw ConfigurationError("Elastic refresh requires max_postponed ({}) to be at least 1!", m_max_postponed);
+      }
+      if (m_max_pulled_in < 0) {
+        throw ConfigurationError("Elastic refresh requires max_pulled_in ({}) to be non-negative!", m_max_pulled_in);
+      }
+    };
+
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      m_dram = m_ctrl->m_dram;
+
+      m_dram_org_levels = m_dram->m_levels.size();
+      m_rank_level = m_dram->m_levels("rank");
+      m_num_ranks = m_dram->get_level_size("rank");
+
+      m_nrefi = m_dram->m_timing_vals("nREFI");
+      m_ref_req_id = m_dram->m_requests("all-bank-refresh");
+      m_ref_cmd_id = m_dram->m_request_translations(m_ref_req_id);
+      if (m_dram->m_commands.contains("PDX") && m_dram->m_commands.contains("SRX")) {
+        m_pdx_cmd_id = m_dram->m_commands("PDX");
+        m_srx_cmd_id = m_dram->m_commands("SRX");
+      }
+
+      m_next_refresh_cycle = m_nrefi;
+      m_owed.resize(m_num_ranks, 0);
+
+      register_stat(s_num_refreshes).name("num_refreshes_{}", m_ctrl->m_channel_id);
+      register_stat(s_num_postponed).name("num_postponed_refreshes_{}", m_ctrl->m_channel_id);
+      register_stat(s_num_pulled_in).name("num_pulled_in_refreshes_{}", m_ctrl->m_channel_id);
+    };
+
+    void tick() {
+      m_clk++;
+
+      if (m_clk == m_next_refresh_cycle) {
+        m_next_refresh_cycle += m_nrefi;
+        for (int r = 0; r < m_num_ranks; r++) {
+          // The debt is paid back oldest first, so the refresh that became due in the slot that just ended is still owed
+          // (i.e., postponed for whatever reason) as long as the rank owes any refresh
+          if (m_owed[r] > 0) {
+            s_num_postponed++;
+          }
+          m_owed[r]++;
+        }
+      }
+
+      bool is_busy_ = is_busy();
+      if (!is_idle()) {
+        m_idle_start_cycle = -1;
+      } else if (m_idle_start_cycle == -1) {
+        m_idle_start_cycle = m_clk;
+      }
+      bool can_pull_in = m_idle_start_cycle != -1 && m_clk - m_idle_start_cycle >= m_pull_in_delay;
+
+      for (int r = 0; r < m_num_ranks; r++) {
+        if (int wakeup_cmd = get_wakeup_command(r); wakeup_cmd != -1) {
+          // A rank in self-refresh refreshes itself, and a pulled-in refresh should not wake up a rank in power-down
+          if (wakeup_cmd == m_srx_cmd_id) {
+            m_owed[r] = std::min(m_owed[r], 0);
+          } else if (m_owed[r] > 0) {
+            try_send_refresh(r);
+          }
+          continue;
+        }
+        if (m_owed[r] > 0) {
+          if (!is_busy_ && get_pull_in_clk(r) <= m_clk) {
+            // Pay the debt back while the read queue is short
+            try_send_refresh(r);
+          } else if (m_owed[r] >= m_max_postponed) {
+            // The rank cannot postpone any more
+            try_send_refresh(r);
+          }
+        } else if (can_pull_in && m_owed[r] > -m_max_pulled_in && get_pull_in_clk(r) <= m_clk) {
+          if (try_send_refresh(r)) {
+            s_num_pulled_in++;
+          }
+        }
+      }
+    };
+
+    Clk_t get_next_event_cycle() override {
+      // Owed refreshes are issued as soon as the read queue drains, pulled-in ones once the controller has been idle long enough
+      Clk_t next_event_cycle = m_next_refresh_cycle;
+      for (int r = 0; r < m_num_ranks; r++) {
+        if (m_owed[r] > 0) {
+          return m_clk + 1;
+        }
+        if (m_owed[r] > -m_max_pulled_in && is_idle() && get_wakeup_command(r) == -1) {
+          // The idle period has to be observed by tick() first
+          Clk_t pull_in_cycle = m_idle_start_cycle == -1 ? m_clk + 1 : m_idle_start_cycle + m_pull_in_delay;
+          next_event_cycle = std::min(next_event_cycle, std::max({get_pull_in_clk(r), pull_in_cycle, m_clk + 1}));
+        }
+      }
+      return next_event_cycle;
+    };
+
+    void fast_forward(Clk_t num_cycles) override {
+      m_clk += num_cycles;
+    };
+
+  private:
+    bool is_busy() {
+      return m_ctrl->get_read_queue_length() >= static_cast<size_t>(m_postpone_threshold);
+    };
+
+    bool is_idle() {
+      return m_ctrl->get_read_queue_length() == 0 &&
+             m_ctrl->get_write_queue_length() == 0 &&
+             m_ctrl->get_active_buffer_length() == 0 &&
+             m_ctrl->get_priority_queue_length() == 0;
+    };
+
+    AddrVec_t get_addr_vec(int rank_id) {
+      AddrVec_t addr_vec(m_dram_org_levels, -1);
+      addr_vec[0] = m_ctrl->m_channel_id;
+      addr_vec[m_rank_level] = rank_id;
+      return addr_vec;
+    };
+
+    /**
+     * @brief    Returns the earliest cycle at which a refresh of the rank can start right away.
+     * @details
+     * A postponed or pulled-in refresh is only sent when its first command (the refresh itself or the precharge
+     * before it) is ready. It is then usually issued right away, instead of waiting in the priority buffer and blocking
+     * the requests that arrive in the meantime (see try_send_refresh() for when it does not).
+     *
+     */
+    Clk_t get_pull_in_clk(int rank_id) {
+      AddrVec_t addr_vec = get_addr_vec(rank_id);
+      int command = m_dram->get_preq_command(m_ref_cmd_id, addr_vec);
+      return m_dram->get_ready_clk(command, addr_vec);
+    };
+
+    /**
+     * @brief    Returns the command that wakes up the rank (in power-down or self-refresh) before a refresh, or -1 if it is awake.
+     * 
+     */
+    int get_wakeup_command(int rank_id) {
+      if (m_srx_cmd_id == -1) {
+        return -1;
+      }
+      int command = m_dram->get_preq_command(m_ref_cmd_id, get_addr_vec(rank_id));
+      return (command == m_pdx_cmd_id || command == m_srx_cmd_id) ? command : -1;
+    };
+
+    /**
+     * @brief    Sends a refresh to the rank, unless the priority buffer still holds a request (e.g., a refresh sent earlier).
+     * @details
+     * The controller serves the active buffer before the priority buffer, so a ready refresh can still wait in the
+     * priority buffer for a few cycles. Sending more refreshes in the meantime would queue several of them at once,
+     * and every queued one blocks the scheduling of the read and write buffers.
+     *
+     * @return   Whether the refresh was sent.
+     */
+    bool try_send_refresh(int rank_id) {
+      if (m_ctrl->get_priority_queue_length() != 0) {
+        return false;
+      }
+      send_refresh(rank_id);
+      return true;
+    };
+
+    void send_refresh(int rank_id) {
+      Request req(get_addr_vec(rank_id), m_ref_req_id);
+
+      bool is_success = m_ctrl->priority_send(req);
+      if (!is_success) {
+        throw std::runtime_error("Failed to send refresh!");
+      }
+      m_owed[rank_id]--;
+      s_num_refreshes++;
+    };
+
+};
+
+}       // namespace Ramulator
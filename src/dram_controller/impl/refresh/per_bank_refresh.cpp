@@ -0,0 +1,287 @@
+#include <vector>
+
+#include "base/base.h"
+#include "dram_controller/controller.h"
+#include "dram_controller/refresh.h"
+
+namespace Ramulator {
+
+/**
+ * @brief    Same-bank (DDR5) or per-bank (LPDDR5, HBM, GDDR6) refresh.
+ * @details
+ * nREFI is divided over the refresh units (i.e., the banks refreshed by one command) of a rank, and
+ * each unit becomes due once per nREFI in a round-robin order. A due unit with queued row hits is
+ * postponed until it owes max_postponed refreshes. While the controller is idle, refreshes are pulled
+ * in one at a time, on any cycle and across all units, until every unit is max_pulled_in refreshes
+ * ahead. The unit that is the fewest refreshes ahead goes first. A rank in self-refresh refreshes itself
+ * and owes nothing, and a rank in power-down is never woken up for a pulled-in refresh.
+ *
+ */
+class PerBankRefresh : public IRefreshManager, public Implementation {
+  RAMULATOR_REGISTER_IMPLEMENTATION(IRefreshManager, PerBankRefresh, "PerBank", "Same-bank/per-bank refresh scheme.")
+  private:
+    struct RefreshUnit {
+      AddrVec_t addr_vec;               // The address of the refresh command
+      std::vector<AddrVec_t> banks;     // The addresses of the banks refreshed by the command
+      int owed = 0;                     // The number of refreshes owed (negative if pulled in)
+    };
+
+    Clk_t m_clk = 0;
+    IDRAM* m_dram;
+    IDRAMController* m_ctrl;
+
+    int m_max_postponed = -1;
+    int m_max_pulled_in = -1;
+
+    int m_ref_req_id = -1;
+    int m_ref_cmd_id = -1;
+    int m_pdx_cmd_id = -1;                          // The power-down and self-refresh exit commands, if the DRAM supports them
+    int m_srx_cmd_id = -1;
+    Clk_t m_refresh_interval = -1;                  // nREFI divided over the refresh units of a rank
+    Clk_t m_next_refresh_cycle = -1;
+
+    std::vector<std::vector<RefreshUnit>> m_units;  // The refresh units of each rank
+    int m_due_unit = 0;                             // The unit (of every rank) that becomes due next
+
+    size_t s_num_refreshes = 0;
+    size_t s_num_postponed = 0;
+    size_t s_num_pulled_in = 0;
+
+  public:
+    void init() override {
+      m_ctrl = cast_parent<IDRAMController>();
+
+      m_max_postponed = param<int>("max_postponed").desc("The maximum number of refreshes a bank can owe (JEDEC allows 4 in the normal refresh mode).").default_val(4);
+      m_max_pulled_in = param<int>("max_pulled_in").desc("The maximum number of refreshes a bank can be refreshed ahead of time.").default_val(4);
+    };
+
+    void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+      m_dram = m_ctrl->m_dram;
+
+      bool is_same_bank = false;
+      if (m_dram->m_requests.contains("same-bank-refresh")) {
+        m_ref_req_id = m_dram->m_requests("same-bank-refresh");
+        is_same_bank = true;
+      } else if (m_dram->m_requests.contains("per-bank-refresh")) {
+        m_ref_req_id = m_dram->m_requests("per-bank-refresh");
+      } else {
+        throw ConfigurationError("PerBank refresh requires a DRAM with a same-bank-refresh or per-bank-refresh request!");
+      }
+      m_ref_cmd_id = m_dram->m_request_translations(m_ref_req_id);
+      if (m_dram->m_commands.contains("PDX") && m_dram->m_commands.contains("SRX")) {
+        m_pdx_cmd_id = m_dram->m_commands("PDX");
+        m_srx_cmd_id = m_dram->m_commands("SRX");
+      }
+
+      int num_levels = m_dram->m_levels.size();
+      // Standards without ranks (e.g., HBM, GDDR6) refresh all banks of the channel with REFab
+      int rank_level = m_dram->m_levels.contains("rank") ? m_dram->m_levels("rank") : 0;
+      int bank_level = m_dram->m_levels("bank");
+      int num_ranks = rank_level == 0 ? 1 : m_dram->m_organization.count[rank_level];
+      int scope = m_dram->m_command_scopes(m_dram->m_request_translations(m_ref_req_id));
+
+      int num_banks = 1;
+      for (int level = rank_level + 1; level <= bank_level; level++) {
+        num_banks *= m_dram->m_organization.count[level];
+      }
+
+      // Which banks are refreshed together by one command:
+      //  - Same-bank refresh (DDR5 REFsb) refreshes the same bank of all bankgroups.
+      //  - A bank-level per-bank refresh (HBM REFsb, GDDR6 REFpb) refreshes a single bank.
+      //  - A rank-level per-bank refresh (LPDDR5 REFpb) refreshes the bank at the flat id and the one num_banks / 2 away.
+      int num_units = is_same_bank ? m_dram->m_organization.count[bank_level] : (scope == bank_level ? num_banks : num_banks / 2);
+
+      m_units.resize(num_ranks, std::vector<RefreshUnit>(num_units));
+      for (int r = 0; r < num_ranks; r++) {
+        AddrVec_t bank_addr_vec(num_levels, -1);
+        bank_addr_vec[0] = m_ctrl->m_channel_id;
+        bank_addr_vec[rank_level] = rank_level == 0 ? m_ctrl->m_channel_id : r;
+
+        for (int flat_bank_id = 0; flat_bank_id < num_banks; flat_bank_id++) {
+          // Decompose the flat id of the bank into its address (the bank is the fastest changing level)
+          int id = flat_bank_id;
+          for (int level = bank_level; level > rank_level; level--) {
+            bank_addr_vec[level] = id % m_dram->m_organization.count[level];
+            id /= m_dram->m_organization.count[level];
+          }
+
+          int unit_id = -1;
+          AddrVec_t unit_addr_vec(num_levels, -1);
+          unit_addr_vec[0] = bank_addr_vec[0];
+          unit_addr_vec[rank_level] = bank_addr_vec[rank_level];
+          if (is_same_bank) {
+            unit_id = bank_addr_vec[bank_level];
+            unit_addr_vec[bank_level] = unit_id;
+          } else if (scope == bank_level) {
+            unit_id = flat_bank_id;
+            unit_addr_vec = bank_addr_vec;
+          } else {
+            unit_id = flat_bank_id % num_units;
+            unit_addr_vec[bank_level] = unit_id;
+          }
+
+          RefreshUnit& unit = m_units[r][unit_id];
+          unit.addr_vec = unit_addr_vec;
+          unit.banks.push_back(bank_addr_vec);
+        }
+      }
+
+      m_refresh_interval = std::max<Clk_t>(m_dram->m_timing_vals("nREFI") / num_units, 1);
+      m_next_refresh_cycle = m_refresh_interval;
+
+      register_stat(s_num_refreshes).name("num_bank_refreshes_{}", m_ctrl->m_channel_id);
+      register_stat(s_num_postponed).name("num_postponed_bank_refreshes_{}", m_ctrl->m_channel_id);
+      register_stat(s_num_pulled_in).name("num_pulled_in_bank_refreshes_{}", m_ctrl->m_channel_id);
+    };
+
+    void tick() {
+      m_clk++;
+
+      if (m_clk == m_next_refresh_cycle) {
+        m_next_refresh_cycle += m_refresh_interval;
+        for (auto& units : m_units) {
+          units[m_due_unit].owed++;
+          refresh_rank(units);
+        }
+        m_due_unit = (m_due_unit + 1) % m_units[0].size();
+      }
+
+      // Refresh ahead of time while the controller is idle (a queued refresh makes it busy, so at most one is sent)
+      for (auto& units : m_units) {
+        if (!is_idle()) {
+          break;
+        }
+        if (get_wakeup_command(units[0]) != -1) {
+          continue;
+        }
+        RefreshUnit* unit = get_pull_in_unit(units);
+        if (unit && get_ready_clk(*unit) <= m_clk) {
+          if (unit->owed <= 0) {
+            s_num_pulled_in++;
+          }
+          send_refresh(*unit);
+        }
+      }
+    };
+
+    Clk_t get_next_event_cycle() override {
+      Clk_t next_event_cycle = m_next_refresh_cycle;
+      if (is_idle()) {
+        for (auto& units : m_units) {
+          if (get_wakeup_command(units[0]) != -1) {
+            continue;
+          }
+          if (RefreshUnit* unit = get_pull_in_unit(units)) {
+            next_event_cycle = std::min(next_event_cycle, std::max(get_ready_clk(*unit), m_clk + 1));
+          }
+        }
+      }
+      return next_event_cycle;
+    };
+
+    void fast_forward(Clk_t num_cycles) override {
+      m_clk += num_cycles;
+    };
+
+  private:
+    void refresh_rank(std::vector<RefreshUnit>& units) {
+      int num_units = units.size();
+
+      int wakeup_cmd = get_wakeup_command(units[0]);
+      if (wakeup_cmd != -1 && wakeup_cmd == m_srx_cmd_id) {
+        // The rank refreshes itself in self-refresh
+        for (auto& unit : units) {
+          unit.owed = std::min(unit.owed, 0);
+        }
+        return;
+      }
+
+      // Pay the owed refreshes, starting from the unit that became due the earliest
+      for (int i = 1; i <= num_units; i++) {
+        RefreshUnit& unit = units[(m_due_unit + i) % num_units];
+        if (unit.owed <= 0) {
+          continue;
+        }
+        if (unit.owed < m_max_postponed && has_row_hits(unit)) {
+          if (i == num_units) {
+            // Only count the refresh that just became due
+            s_num_postponed++;
+          }
+          continue;
+        }
+        while (unit.owed > 0) {
+          send_refresh(unit);
+        }
+      }
+    };
+
+    bool is_idle() {
+      return m_ctrl->get_read_queue_length() == 0 &&
+             m_ctrl->get_write_queue_length() == 0 &&
+             m_ctrl->get_active_buffer_length() == 0 &&
+             m_ctrl->get_priority_queue_length() == 0;
+    };
+
+    /**
+     * @brief    Returns the unit of the rank to refresh ahead of time, or nullptr if every unit is max_pulled_in refreshes ahead.
+     * @details
+     * Picks the unit that is the fewest refreshes ahead (or still owes one), and among those the one that becomes due the earliest.
+     *
+     */
+    RefreshUnit* get_pull_in_unit(std::vector<RefreshUnit>& units) {
+      int num_units = units.size();
+      RefreshUnit* candidate = nullptr;
+      for (int i = 0; i < num_units; i++) {
+        RefreshUnit& unit = units[(m_due_unit + i) % num_units];
+        if (unit.owed > -m_max_pulled_in && (!candidate || unit.owed > candidate->owed)) {
+          candidate = &unit;
+        }
+      }
+      return candidate;
+    };
+
+    /**
+     * @brief    Returns the earliest cycle at which the first command of a refresh of the unit (the refresh itself or a precharge) is ready.
+     * @details
+     * A pulled-in refresh is only sent once it can issue right away, so that it does not sit in the priority buffer
+     * and block the requests that arrive in the meantime.
+     *
+     */
+    Clk_t get_ready_clk(const RefreshUnit& unit) {
+      int command = m_dram->get_preq_command(m_ref_cmd_id, unit.addr_vec);
+      return m_dram->get_ready_clk(command, unit.addr_vec);
+    };
+
+    /**
+     * @brief    Returns the command that wakes up the rank (in power-down or self-refresh) of the unit before a refresh, or -1 if it is awake.
+     * 
+     */
+    int get_wakeup_command(const RefreshUnit& unit) {
+      if (m_srx_cmd_id == -1) {
+        return -1;
+      }
+      int command = m_dram->get_preq_command(m_ref_cmd_id, unit.addr_vec);
+      return (command == m_pdx_cmd_id || command == m_srx_cmd_id) ? command : -1;
+    };
+
+    bool has_row_hits(const RefreshUnit& unit) {
+      for (const auto& bank_addr_vec : unit.banks) {
+        if (m_ctrl->has_pending_row_hits(bank_addr_vec)) {
+          return true;
+        }
+      }
+      return false;
+    };
+
+    void send_refresh(RefreshUnit& unit) {
+      Request req(unit.addr_vec, m_ref_req_id);
+      bool is_success = m_ctrl->priority_send(req);
+      if (!is_success) {
+        throw std::runtime_error("Failed to send refresh!");
+      }
+      unit.owed--;
+      s_num_refreshes++;
+    };
+};
+
+}       // namespace Ramulator
@@ -1,4 +1,5 @@
 #include <vector>
+#include <algorithm>
 
 #include "base/base.h"
 #include "dram_controller/controller.h"
@@ -11,11 +12,23 @@ class FRFCFS : public IScheduler, public Implementation {
   private:
     IDRAM* m_dram;
 
+    bool m_is_incremental = false;
+    int m_channel_id = -1;
+    int m_bank_level = -1;
+    uint64_t m_state_epoch = 0;                 // The state epoch of the channel that the cached commands are valid for
+    std::vector<ReqBuffer*> m_cached_buffers;   // The buffers whose row groups carry cached commands
+
   public:
-    void init() override { };
+    void init() override { 
+      m_is_incremental = param<bool>("incremental").desc("Cache the prerequisite command and readiness of each row group across cycles.").default_val(false);
+    };
 
     void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
-      m_dram = cast_parent<IDRAMController>()->m_dram;
+      auto controller = cast_parent<IDRAMController>();
+      m_dram = controller->m_dram;
+      m_channel_id = controller->m_channel_id;
+      m_bank_level = m_dram->m_levels("bank");
+      m_state_epoch = m_dram->get_state_epoch(m_channel_id);
     };
 
     ReqBuffer::iterator compare(ReqBuffer::iterator req1, ReqBuffer::iterator req2) override {
@@ -43,6 +56,10 @@ class FRFCFS : public IScheduler, public Implementation {
         return buffer.end();
       }
 
+      if (buffer.is_bank_indexed()) {
+        return get_best_group_head(buffer);
+      }
+
       for (auto& req : buffer) {
         req.command = m_dram->get_preq_command(req.final_command, req.addr_vec);
       }
@@ -53,6 +70,117 @@ class FRFCFS : public IScheduler, public Implementation {
       }
       return candidate;
     }
+
+    void update(bool request_found, ReqBuffer::iterator& req_it) override {
+      if (!m_is_incremental || !request_found) {
+        return;
+      }
+
+      // Row reads and writes do not change the state of any node
+      int command = req_it->command;
+      const auto& meta = m_dram->m_command_meta(command);
+      if (!(meta.is_accessing && !meta.is_closing)) {
+        // The command only changes the state of the nodes in its scope (at most the bank)
+        int scope = std::min(static_cast<int>(m_dram->m_command_scopes(command)), m_bank_level);
+        const AddrVec_t& addr_vec = req_it->addr_vec;
+        for (auto buffer : m_cached_buffers) {
+          buffer->for_each_group_head([&](ReqBuffer::iterator head, ReqBuffer::GroupCache& cache) {
+            if (is_in_scope(head->addr_vec, addr_vec, scope)) {
+              cache.is_valid = false;
+            }
+          });
+        }
+      }
+
+      // Issuing the command updates the states of the channel once
+      m_state_epoch++;
+    };
+
+  private:
+    static bool is_in_scope(const AddrVec_t& addr_vec, const AddrVec_t& scope_addr_vec, int scope) {
+      for (int level = 0; level <= scope; level++) {
+        if (addr_vec[level] != -1 && scope_addr_vec[level] != -1 && addr_vec[level] != scope_addr_vec[level]) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    /**
+     * @brief    Drops all cached commands if the channel states changed in a way we did not track.
+     * @details
+     * E.g., future actions (refresh ends), commands issued by other components, or clock dependent
+     * prerequisites (LPDDR5).
+     */
+    void check_state_epoch(ReqBuffer& buffer) {
+      if (std::find(m_cached_buffers.begin(), m_cached_buffers.end(), &buffer) == m_cached_buffers.end()) {
+        m_cached_buffers.push_back(&buffer);
+      }
+
+      uint64_t epoch = m_dram->get_state_epoch(m_channel_id);
+      if (epoch != m_state_epoch) {
+        for (auto cached_buffer : m_cached_buffers) {
+          cached_buffer->for_each_group_head([](ReqBuffer::iterator, ReqBuffer::GroupCache& cache) {
+            cache.is_valid = false;
+          });
+        }
+        m_state_epoch = epoch;
+      }
+    }
+
+    /**
+     * @brief    Same as the full scan, but only resolves the oldest request of each row group.
+     * @details
+     * All requests of a row group have the same prerequisite command and readiness, and the 
+     * oldest one always wins the FCFS tie-break, so the other requests can never be picked.
+     * 
+     * In incremental mode, the prerequisite command of a group is kept until a command is issued 
+     * to its bank (or a wider scope), and the earliest cycle it can be issued at is kept until any 
+     * command is issued to the channel.
+     */
+    ReqBuffer::iterator get_best_group_head(ReqBuffer& buffer) {
+      if (m_is_incremental) {
+        check_state_epoch(buffer);
+      }
+
+      ReqBuffer::iterator candidate = buffer.end();
+      bool candidate_ready = false;
+      buffer.for_each_group_head([&](ReqBuffer::iterator head, ReqBuffer::GroupCache& cache) {
+        if (!m_is_incremental || !cache.is_valid) {
+          cache.command = m_dram->get_preq_command(head->final_command, head->addr_vec);
+          cache.is_valid = true;
+          cache.is_ready_valid = false;
+        }
+        head->command = cache.command;
+
+        bool ready = false;
+        if (m_is_incremental) {
+          if (!cache.is_ready_valid || cache.ready_epoch != m_state_epoch) {
+            cache.ready_clk = m_dram->get_ready_clk(head->command, head->addr_vec);
+            cache.is_ready_valid = true;
+            cache.ready_epoch = m_state_epoch;
+          }
+          ready = cache.ready_clk <= m_dram->get_clk();
+        } else {
+          ready = m_dram->check_ready(head->command, head->addr_vec);
+        }
+
+        bool is_better = false;
+        if (candidate == buffer.end() || ready != candidate_ready) {
+          is_better = (candidate == buffer.end()) || ready;
+        } else if (head->arrive != candidate->arrive) {
+          is_better = head->arrive < candidate->arrive;
+        } else {
+          is_better = ReqBuffer::is_enqueued_before(head, candidate);
+        }
+
+        if (is_better) {
+          candidate = head;
+          candidate_ready = ready;
+        }
+      });
+      return candidate;
+    }
 };
 
 }       // namespace Ramulator
@@ -18,6 +18,29 @@ class IControllerPlugin {
 
   public:
     virtual void update(bool request_found, ReqBuffer::iterator& req_it) = 0;
+
+    /**
+     * @brief    Returns the earliest controller cycle at which update() may do more than advancing the clock of the plugin.
+     * @details
+     * Commands issued by the controller are events of the controller itself and need not be reported. A cycle that 
+     * is not in the future (e.g., 0, the default) disables fast-forwarding over the controller.
+     * 
+     */
+    virtual Clk_t get_next_event_cycle() { return 0; };
+
+    /**
+     * @brief    Advances the plugin by num_cycles updates that find no request (see get_next_event_cycle()).
+     * 
+     */
+    virtual void fast_forward(Clk_t num_cycles) {};
+
+    /**
+     * @brief    Whether a request sent by the plugin to the priority buffer is no longer wanted and should be dropped.
+     * @details
+     * Called before the request at the head of the priority buffer is scheduled.
+     * 
+     */
+    virtual bool is_withdrawn(const Request& req) { return false; };
 };
 
 }        // namespace Ramulator
@@ -14,6 +14,18 @@ class IRefreshManager {
 
   public:
     virtual void tick() = 0;
+
+    /**
+     * @brief    Returns the cycle at which the next refresh request will be generated.
+     * 
+     */
+    virtual Clk_t get_next_event_cycle() = 0;
+
+    /**
+     * @brief    Advances the refresh manager by num_cycles ticks that generate no refresh request.
+     * 
+     */
+    virtual void fast_forward(Clk_t num_cycles) = 0;
 };
 
 }        // namespace Ramulator
@@ -16,6 +16,12 @@ class IScheduler {
     virtual ReqBuffer::iterator compare(ReqBuffer::iterator req1, ReqBuffer::iterator req2) = 0;
 
     virtual ReqBuffer::iterator get_best_request(ReqBuffer& buffer) = 0;
+
+    /**
+     * @brief    Called by the controller with the scheduling decision of this cycle, before the command is issued.
+     * 
+     */
+    virtual void update(bool request_found, ReqBuffer::iterator& req_it) {};
 };
 
 }       // namespace Ramulator
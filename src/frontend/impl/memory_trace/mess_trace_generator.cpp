@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
@@ -8,11 +9,54 @@
 #include <bitset>
 
 #include "base/exception.h"
+#include "base/histogram.h"
 #include "base/request.h"
 #include "base/type.h"
 #include "frontend/frontend.h"
 
 namespace Ramulator {
+
+/**
+ * @brief   Enumerates the addresses of a stream on the fly, wrapping around after the last one.
+ * @details
+ * The stream walks a grid of levels (e.g., row, column, bank), each with a number of steps and a stride in the
+ * address. The levels are ordered from the slowest- to the fastest-changing one, like nested loops, so next()
+ * only has to carry into the slower levels when a faster one wraps around.
+ */
+class StreamAddressIterator {
+ public:
+  struct Level {
+    int64_t num_steps;
+    int64_t stride;
+  };
+
+ private:
+  std::vector<Level> m_levels;
+  std::vector<int64_t> m_steps;  // the current step of each level
+  Addr_t m_base = 0;
+  Addr_t m_offset = 0;           // the sum of step * stride over the levels
+
+ public:
+  StreamAddressIterator() = default;
+  StreamAddressIterator(std::vector<Level> levels, Addr_t base) : m_levels(std::move(levels)), m_steps(m_levels.size(), 0), m_base(base) {}
+
+  bool is_set_up() const { return !m_levels.empty(); }
+
+  Addr_t next() {
+    Addr_t addr = m_base + m_offset;
+    for (int i = m_levels.size() - 1; i >= 0; i--) {
+      if (++m_steps[i] < m_levels[i].num_steps) {
+        m_offset += m_levels[i].stride;
+        return addr;
+      }
+      // this level wraps around and carries into the next slower one
+      m_offset -= (m_levels[i].num_steps - 1) * m_levels[i].stride;
+      m_steps[i] = 0;
+    }
+    return addr;
+  }
+};
+
 class MessReqGenerator : public IFrontEnd, public Implementation {
   RAMULATOR_REGISTER_IMPLEMENTATION(IFrontEnd, MessReqGenerator, "MessReqGenerator", "Sequential Random accesses and Stream traces.")
 
@@ -34,9 +78,11 @@ class MessReqGenerator : public IFrontEnd, public Implementation {
   int shift_amts[6] = {-1, -1, -1, -1, -1, -1};
   int64_t max_val[6] = {-1, -1, -1, -1, -1, -1};
   std::vector<int64_t> channel_offsets;
-  std::vector<Addr_t> stream_addrs;
-  int addr_index;
   int64_t m_num_columns;  // the number of columns we iterate over for STREAM
+  std::string m_stream_order;
+  int64_t m_stream_burst_length;
+  int64_t m_stream_column_stride;
+  int64_t m_stream_row_stride;
 
   size_t random_count;
   bool m_issue_random;
@@ -44,11 +90,31 @@ class MessReqGenerator : public IFrontEnd, public Implementation {
 
   bool m_disable_random;
 
-  bool retry_send_stream;
-  bool retry_send_random;
-  Request m_curr_stride_req = {0, 0};
-  Request m_curr_random_req = {0, 0};
-  Request m_last_random_req = {-1, 0};
+  // an independent pointer chase: it sends its next request once the previous one has finished
+  struct ChaseChain {
+    Addr_t min_addr = 0;
+    Addr_t max_addr = 0;
+    float region_share = 0;       // the share of the address range, 0 for an equal share
+    float read_ratio = 1.0;
+    Request curr_req = {0, 0};
+    Request last_req = {-1, 0};
+    bool is_pending = false;      // curr_req has not been accepted yet
+    size_t s_num_requests = 0;
+    LatencyHistogram s_read_latency;
+  };
+  std::vector<ChaseChain> m_chains;
+
+  // a stream over its own share of the rows
+  struct StreamGenerator {
+    StreamAddressIterator addrs;
+    float region_share = 0;       // the share of the rows, 0 for an equal share
+    std::bernoulli_distribution read_write;
+    Request curr_req = {0, 0};
+    bool is_pending = false;      // curr_req has not been accepted yet
+    size_t s_num_reads = 0;
+    size_t s_num_writes = 0;
+  };
+  std::vector<StreamGenerator> m_streams;
 
   struct Trace {
     bool is_write;
@@ -63,27 +129,46 @@ class MessReqGenerator : public IFrontEnd, public Implementation {
   size_t m_nop_counter;
   size_t m_curr_nop_counter;
 
+  // closed-loop bandwidth control: every control epoch, the NOP counter is adjusted towards the target bandwidth
+  static constexpr double MaxNopCounter = 1e6;
+  float m_target_bandwidth;      // in GB/s, 0 to use the fixed NOP counter
+  Clk_t m_control_epoch;
+  Clk_t m_last_control_tick = 0;
+  Clk_t m_next_control_tick = 0;
+  size_t m_control_transactions = 0;   // transactions accepted by the memory system in this control epoch
+  double m_nop_target = 1.0;           // the NOP counter averages to this, by dithering between its neighboring integers
+  double m_nop_dither = 0.0;
+
+  int64_t m_transaction_bytes = 0;
+  double m_tick_ns = 0.0;
+  size_t s_num_transactions = 0;
+  double s_achieved_bandwidth = 0.0;
+
   std::mt19937 m_gen;
-  std::bernoulli_distribution m_dist_read_write;
+  std::mt19937 m_chase_gen{1337};
 
   size_t m_frontend_ticks = 0;
 
-  bool is_write() {
-    bool is_read = m_dist_read_write(m_gen);
+  bool is_write(StreamGenerator& stream) {
+    bool is_read = stream.read_write(m_gen);
     return !is_read;
   }
 
-  Request get_random_request() {
+  Request get_random_request(int chain_id) {
     if (m_max_addr == -1) {
       set_max_addr();
     }
-    static std::mt19937 gen(1337);
+    ChaseChain& chain = m_chains[chain_id];
     //std::cout << "get random req, max: " << m_max_addr << ", min: " << m_min_addr << std::endl;
-    std::uniform_int_distribution<uint64_t> dist(m_min_addr, m_max_addr);
-    Addr_t addr = dist(gen);
-    Request res = {addr, false};  // pointer chase just does reads
+    std::uniform_int_distribution<uint64_t> dist(chain.min_addr, chain.max_addr);
+    Addr_t addr = dist(m_chase_gen);
+    // pointer chases only read unless configured otherwise
+    bool is_write = chain.read_ratio < 1 && !std::bernoulli_distribution(chain.read_ratio)(m_chase_gen);
+    Request res = {addr, is_write};
     res.request_type = 0;  // set type id to 0 for random request
-    m_curr_random_req = res;
+    if (!is_write) {
+      res.callback = [this, chain_id](Request& req) { m_chains[chain_id].s_read_latency.record(req.depart - req.arrive); };
+    }
     return res;
   }
 
@@ -99,6 +184,20 @@ class MessReqGenerator : public IFrontEnd, public Implementation {
     if (m_max_addr <= m_min_addr) {
       throw ConfigurationError("Invalid address range: max_addr must be > min_addr");
     }
+    // each chain chases in its own share of the address range, the regions are laid out one after the other
+    // (with equal shares, the last chain also gets the remainder of the division)
+    int64_t range = m_max_addr - m_min_addr + 1;
+    Addr_t region_start = m_min_addr;
+    for (size_t i = 0; i < m_chains.size(); i++) {
+      bool is_equal_share = m_chains[i].region_share == 0;
+      int64_t size = is_equal_share ? range / (int64_t)m_chains.size() : (int64_t)(range * m_chains[i].region_share);
+      if (size < 1) {
+        throw ConfigurationError("The address range of pointer-chase chain {} is empty!", i);
+      }
+      m_chains[i].min_addr = region_start;
+      m_chains[i].max_addr = (is_equal_share && i == m_chains.size() - 1) ? m_max_addr : region_start + size - 1;
+      region_start += size;
+    }
   }
 
   void set_up_channel_offsets() {
@@ -150,42 +249,74 @@ class MessReqGenerator : public IFrontEnd, public Implementation {
     channel = 5
   };
 
+  // the number of values of an address field
+  int64_t get_num_values(AddrFields field) {
+    return (max_val[field] >> shift_amts[field]) + 1;
+  }
+
+  // the stride of one step of an address field
+  int64_t get_stride(AddrFields field) {
+    return 1LL << shift_amts[field];
+  }
+
+  // bank_interleaved: row -> column burst -> bank -> bank group -> column within the burst
+  //                   (a burst length of 1 visits every bank between two columns of a row)
+  // row_major:        row -> bank -> bank group -> column (all columns of a row back to back)
+  // each stream walks its own share of the rows, the shares are laid out one after the other
   void setup_stream_addresses() {
     setup_shift_amts();
     set_up_channel_offsets();
-    Addr_t addr = 0;
-    for (int64_t i=0; i < max_val[row]; i += (1LL << shift_amts[row])) {
-      for (int64_t j = 0, s = 0; s < m_num_columns; j += (1LL << shift_amts[column]), s++) { // limit to 8 columns for now -> todo: make configurable
-        for (int64_t k = 0; k < max_val[bank]; k += (1LL << shift_amts[bank])) {
-          for (int64_t l = 0; l < max_val[bankgroup]; l += (1LL << shift_amts[bankgroup])) {
-            // for (int64_t n = 0; n < max_val[rank]; n += (1LL << shift_amts[rank])) {
-              //for (int64_t m = 0; m < max_val[channel]; m += (1LL << shift_amts[channel])) {
-                addr = addr + i + j + k + l; //+ n; // + m;
-                //std::cout << "max bankgroup " << max_val[bankgroup] << ", shift " << shift_amts[bankgroup] << std::endl;
-                //std::cout << "max channel " << max_val[channel] << ", shift " << shift_amts[channel] << std::endl; 
-                //std::cout << "stream addr: " << std::bitset<36>(addr) << std::endl;
-                stream_addrs.push_back(addr);
-                addr = 0;
-              //}
-            // }
-          }
-        }
+    // a stream that runs past the last column (row) would carry into the next field, e.g., into the rows of another stream
+    if (m_num_columns * m_stream_column_stride > get_num_values(column)) {
+      throw ConfigurationError("{} columns with a stride of {} do not fit in a row of {} columns!", m_num_columns, m_stream_column_stride, get_num_values(column));
+    }
+    if (m_stream_row_stride > get_num_values(row)) {
+      throw ConfigurationError("The stream row stride ({}) exceeds the number of rows ({})!", m_stream_row_stride, get_num_values(row));
+    }
+    int64_t total_rows = get_num_values(row) / m_stream_row_stride;
+    int64_t row_stride = m_stream_row_stride * get_stride(row);
+    int64_t column_stride = m_stream_column_stride * get_stride(column);
+
+    std::vector<StreamAddressIterator::Level> levels;
+    if (m_stream_order == "bank_interleaved") {
+      levels = {
+        {0, row_stride},  // the number of rows is set per stream
+        {m_num_columns / m_stream_burst_length, m_stream_burst_length * column_stride},
+        {get_num_values(bank), get_stride(bank)},
+        {get_num_values(bankgroup), get_stride(bankgroup)},
+        {m_stream_burst_length, column_stride},
+      };
+    } else {
+      levels = {
+        {0, row_stride},  // the number of rows is set per stream
+        {get_num_values(bank), get_stride(bank)},
+        {get_num_values(bankgroup), get_stride(bankgroup)},
+        {m_num_columns, column_stride},
+      };
+    }
+    int64_t first_row = 0;
+    for (size_t i = 0; i < m_streams.size(); i++) {
+      float share = m_streams[i].region_share;
+      int64_t num_rows = share == 0 ? total_rows / (int64_t)m_streams.size() : (int64_t)(total_rows * share);
+      if (num_rows < 1) {
+        throw ConfigurationError("Not enough rows for stream {}!", i);
       }
+      levels[0].num_steps = num_rows;
+      m_streams[i].addrs = StreamAddressIterator(levels, first_row * row_stride);
+      first_row += num_rows;
     }
   }
 
-  Request get_next_stream_request() {
+  Request get_next_stream_request(StreamGenerator& stream) {
     if (m_max_addr == -1) {
       set_max_addr();
     }
-    if (stream_addrs.size() == 0) setup_stream_addresses();
-    Addr_t addr = stream_addrs[addr_index];
-    //Addr_t addr = 69;
-    addr_index = (addr_index + 1) % stream_addrs.size();
-    bool is_read = m_dist_read_write(m_gen);
-    Request res = {addr, is_write()};
+    if (!stream.addrs.is_set_up()) setup_stream_addresses();
+    Addr_t addr = stream.addrs.next();
+    // the original generator drew one more read/write sample per request, keep it so that the stream mix is unchanged
+    stream.read_write(m_gen);
+    Request res = {addr, is_write(stream)};
     res.request_type = 1; // set type id to 1 for strided request
-    m_curr_stride_req = res;
     return res;
   }
 
@@ -203,9 +334,12 @@ class MessReqGenerator : public IFrontEnd, public Implementation {
     }
     m_issued_requests = 0;
     m_issue_random = false;
-    retry_send_stream = false;
-    retry_send_random = false;
     m_nop_counter = param<uint>("nop_counter").default_val(1);
+    m_target_bandwidth = param<float>("target_bandwidth").desc("Target bandwidth in GB/s, reached by adjusting the NOP counter every bandwidth_epoch ticks (0 uses the fixed nop_counter).").default_val(0);
+    m_control_epoch = param<Clk_t>("bandwidth_epoch").desc("Number of frontend ticks between two adjustments towards the target bandwidth.").default_val(10000);
+    if (m_target_bandwidth < 0 || m_control_epoch < 1) {
+      throw ConfigurationError("The target bandwidth must not be negative and the bandwidth epoch must be positive!");
+    }
     m_curr_nop_counter = 0;
 
     s_retried_requests = 0; 
@@ -216,11 +350,68 @@ class MessReqGenerator : public IFrontEnd, public Implementation {
     s_total_numer_of_idle_ticks = 0;
     s_total_number_for_idle_ticks_random_reads = 0;
     m_num_columns = param<int64_t>("num_columns").default_val(8);
-    addr_index = 0;
+    m_stream_order = param<std::string>("stream_order").desc("Order of the stream addresses (bank_interleaved or row_major).").default_val("bank_interleaved");
+    m_stream_burst_length = param<int64_t>("stream_burst_length").desc("Number of consecutive columns of a row accessed before moving to the next bank (bank_interleaved order).").default_val(1);
+    m_stream_column_stride = param<int64_t>("stream_column_stride").desc("Stride between the columns of the stream, in columns.").default_val(1);
+    m_stream_row_stride = param<int64_t>("stream_row_stride").desc("Stride between the rows of the stream, in rows.").default_val(1);
+    if (m_stream_order != "bank_interleaved" && m_stream_order != "row_major") {
+      throw ConfigurationError("Unrecognized stream order \"{}\" (expected bank_interleaved or row_major)!", m_stream_order);
+    }
+    if (m_num_columns < 1 || m_stream_burst_length < 1 || m_num_columns % m_stream_burst_length != 0) {
+      throw ConfigurationError("The stream burst length ({}) must divide the number of columns ({})!", m_stream_burst_length, m_num_columns);
+    }
+    if (m_stream_column_stride < 1 || m_stream_row_stride < 1) {
+      throw ConfigurationError("The stream strides must be positive!");
+    }
+
+    int num_chase_chains = param<int>("num_chase_chains").desc("Number of independent pointer-chase chains, each in its own share of the address range.").default_val(1);
+    int num_streams = param<int>("num_streams").desc("Number of stream generators, each over its own share of the rows.").default_val(1);
+    std::vector<float> chase_region_shares = param<std::vector<float>>("chase_region_shares").desc("Share of the address range of each pointer-chase chain (equal shares by default).").default_val({});
+    std::vector<float> stream_region_shares = param<std::vector<float>>("stream_region_shares").desc("Share of the rows of each stream (equal shares by default).").default_val({});
+    std::vector<float> chase_ratio_reads = param<std::vector<float>>("chase_ratio_reads").desc("Read ratio of each pointer-chase chain (all reads by default).").default_val({});
+    std::vector<float> stream_ratio_reads = param<std::vector<float>>("stream_ratio_reads").desc("Read ratio of each stream (ratio_reads by default).").default_val({});
+    if (num_chase_chains < 1 || num_streams < 1) {
+      throw ConfigurationError("The Mess generator needs at least one pointer-chase chain and one stream!");
+    }
+    if (chase_ratio_reads.empty()) chase_ratio_reads.resize(num_chase_chains, 1.0);
+    if (stream_ratio_reads.empty()) stream_ratio_reads.resize(num_streams, m_read_ratio);
+    if (chase_ratio_reads.size() != static_cast<size_t>(num_chase_chains) || stream_ratio_reads.size() != static_cast<size_t>(num_streams)) {
+      throw ConfigurationError("Expected a read ratio for each of the {} chains and {} streams!", num_chase_chains, num_streams);
+    }
+    if (chase_region_shares.empty()) chase_region_shares.resize(num_chase_chains, 0);
+    if (stream_region_shares.empty()) stream_region_shares.resize(num_streams, 0);
+    if (chase_region_shares.size() != static_cast<size_t>(num_chase_chains) || stream_region_shares.size() != static_cast<size_t>(num_streams)) {
+      throw ConfigurationError("Expected a region share for each of the {} chains and {} streams!", num_chase_chains, num_streams);
+    }
+    for (const auto& shares : {chase_region_shares, stream_region_shares}) {
+      bool is_equal = std::all_of(shares.begin(), shares.end(), [](float share) { return share == 0; });
+      bool is_valid = std::all_of(shares.begin(), shares.end(), [](float share) { return share > 0 && share <= 1; });
+      float total = 0;
+      for (float share : shares) total += share;
+      if (!is_equal && (!is_valid || total > 1 + 1e-6)) {
+        throw ConfigurationError("The region shares must be positive and add up to at most 1!");
+      }
+    }
+    for (float ratio : chase_ratio_reads) {
+      if (ratio > 1 || ratio < 0) throw ConfigurationError("Read ration must be between 0 and 1!");
+    }
+    for (float ratio : stream_ratio_reads) {
+      if (ratio > 1 || ratio < 0) throw ConfigurationError("Read ration must be between 0 and 1!");
+    }
+
+    m_chains.resize(num_chase_chains);
+    for (int i = 0; i < num_chase_chains; i++) {
+      m_chains[i].region_share = chase_region_shares[i];
+      m_chains[i].read_ratio = chase_ratio_reads[i];
+    }
+    m_streams.resize(num_streams);
+    for (int i = 0; i < num_streams; i++) {
+      m_streams[i].region_share = stream_region_shares[i];
+      m_streams[i].read_write = std::bernoulli_distribution(stream_ratio_reads[i]);
+    }
 
     std::seed_seq seed{342};
     m_gen = std::mt19937(seed);
-    m_dist_read_write = std::bernoulli_distribution(m_read_ratio);
     register_stat(m_total_requests).name("total_number_of_issued_requests");
     register_stat(s_retried_requests).name("total_number_of_retried_requests");
     register_stat(s_random_reads).name("total_number_of_random_reads");
@@ -229,79 +420,142 @@ class MessReqGenerator : public IFrontEnd, public Implementation {
     register_stat(s_stride_writes).name("total_number_of_stride_writes");
     register_stat(m_read_ratio).name("read_ratio");
     register_stat(m_nop_counter).name("nop_counter_value");
+    register_stat(m_target_bandwidth).name("target_bandwidth");
+    register_stat(s_achieved_bandwidth).name("achieved_bandwidth");
+    register_stat(s_num_transactions).name("total_number_of_transactions");
     register_stat(s_total_numer_of_idle_ticks).name("s_total_numer_of_idle_ticks");
     register_stat(s_total_number_for_idle_ticks_random_reads).name("s_total_number_for_idle_ticks_random_reads");
     register_stat(m_max_addr).name("max_address");
     register_stat(m_num_columns).name("num_columns");
+    for (int i = 0; i < num_chase_chains; i++) {
+      register_stat(m_chains[i].s_num_requests).name("num_chase_requests_chain_{}", i);
+      register_stat(m_chains[i].s_read_latency).name("chase_read_latency_chain_{}", i);
+    }
+    for (int i = 0; i < num_streams; i++) {
+      register_stat(m_streams[i].s_num_reads).name("num_stream_reads_{}", i);
+      register_stat(m_streams[i].s_num_writes).name("num_stream_writes_{}", i);
+    }
 
     random_count = 0;
   };
 
 
-  void update_stats() {
-    if (m_curr_random_req.type_id == Request::Type::Read && !m_issue_random) {
-      s_random_reads ++;
-    } else if (m_curr_stride_req.type_id == Request::Type::Read && m_issue_random) {
-      s_stride_reads ++;
-    } else if (m_curr_random_req.type_id == Request::Type::Write && !m_issue_random) {
-      s_random_writes ++;
-    } else {
-      s_stride_writes ++;
-    }
-  }
-
   // sends a requests to all channels 
   // by adding the channel offset to the address
   bool send_request(Request req) {
     bool sent = false;
-    for (int i=0; i<channel_offsets.size(); i++) {
+    for (size_t i=0; i<channel_offsets.size(); i++) {
       Request req_i = req;
       req_i.addr += channel_offsets[i];
+      // only the copy to channel 0 (the one a chase waits for, see is_chain_ready()) calls back
+      if (i != 0) req_i.callback = nullptr;
       sent = m_memory_system->send(req_i);
+      if (sent) {
+        s_num_transactions++;
+        m_control_transactions++;
+      }
     }
     return sent;
   }
+
+  // in GB/s
+  double get_bandwidth(size_t num_transactions, Clk_t num_ticks) {
+    if (num_ticks == 0) return 0.0;
+    return num_transactions * m_transaction_bytes / (num_ticks * m_tick_ns);
+  }
+
+  // the bandwidth is roughly inversely proportional to the NOP counter, so the NOP target is scaled by the
+  // ratio of the achieved to the target bandwidth (damped by a square root to avoid oscillating)
+  void update_issue_rate() {
+    double bandwidth = get_bandwidth(m_control_transactions, m_frontend_ticks - m_last_control_tick);
+    double correction = bandwidth > 0 ? std::sqrt(bandwidth / m_target_bandwidth) : 0.5;
+    m_nop_target = std::clamp(m_nop_target * correction, 1.0, MaxNopCounter);
+    set_nop_counter();
+    m_logger->debug("Tick {}: {} GB/s, NOP counter {} (target {})", m_frontend_ticks, bandwidth, m_nop_counter, m_nop_target);
+
+    m_control_transactions = 0;
+    m_last_control_tick = m_frontend_ticks;
+    m_next_control_tick = m_frontend_ticks + m_control_epoch;
+  }
+
+  void set_nop_counter() {
+    m_nop_dither += m_nop_target - std::floor(m_nop_target);
+    m_nop_counter = std::floor(m_nop_target);
+    if (m_nop_dither >= 1.0) {
+      m_nop_counter++;
+      m_nop_dither -= 1.0;
+    }
+    m_curr_nop_counter %= m_nop_counter;
+  }
   
-  bool issue_request() {
-    bool sent = false;
-    if (m_issue_random) {
-      Request req = {0, 0};
-      if (retry_send_random) {
-        req = m_curr_random_req;
-      } else {
-        req = get_random_request();
+  // a chase turn sends one request from every chain whose previous request has finished,
+  // and it ends once all of them have been accepted (rejected ones are retried in the next ticks)
+  void issue_random_requests() {
+    size_t num_pending = 0;
+    for (auto& chain : m_chains) num_pending += chain.is_pending;
+    if (num_pending == 0) {
+      for (size_t i = 0; i < m_chains.size(); i++) {
+        if (random_count + num_pending < m_total_requests && is_chain_ready(m_chains[i])) {
+          m_chains[i].curr_req = get_random_request(i);
+          m_chains[i].is_pending = true;
+          num_pending++;
+        }
       }
+    }
 
+    for (auto& chain : m_chains) {
+      if (!chain.is_pending) continue;
+      bool sent = false;
       if (m_disable_random)
         sent = true;
       else
-        sent = send_request(req);
-    
+        sent = send_request(chain.curr_req);
+
       if (sent) {  // request accepted by MC
         random_count += 1;
-        m_last_random_req = req;
-        m_issue_random = !m_issue_random;
-        retry_send_random = false;
+        m_issued_requests++;
+        chain.last_req = chain.curr_req;
+        chain.is_pending = false;
+        chain.s_num_requests++;
+        num_pending--;
+        if (chain.curr_req.type_id == Request::Type::Read) s_random_reads ++;
+        else s_random_writes ++;
       } else {  // request rejected by MC -> we need to retry sending it
-        retry_send_random = true;
+        s_retried_requests ++;
       }
-      
-    } else {  // issue stream
-      Request req = {0, 0};
-      if (retry_send_stream) {
-        req = m_curr_stride_req;
-      } else {  // issue new request
-        req = get_next_stream_request();
+    }
+    if (num_pending == 0) m_issue_random = false;
+  }
+
+  // a stream turn sends one request from every stream, and it ends once all of them have been accepted
+  void issue_stream_requests() {
+    bool is_retry = false;
+    for (auto& stream : m_streams) is_retry |= stream.is_pending;
+
+    bool is_done = true;
+    for (auto& stream : m_streams) {
+      if (!is_retry) {  // issue new request
+        stream.curr_req = get_next_stream_request(stream);
+        stream.is_pending = true;
       }
-      sent = send_request(req);
-      if (sent) {
-        retry_send_stream = false;
-        m_issue_random = !m_issue_random;
+      if (!stream.is_pending) continue;
+
+      if (send_request(stream.curr_req)) {
+        m_issued_requests++;
+        stream.is_pending = false;
+        if (stream.curr_req.type_id == Request::Type::Read) {
+          s_stride_reads ++;
+          stream.s_num_reads ++;
+        } else {
+          s_stride_writes ++;
+          stream.s_num_writes ++;
+        }
       } else {
-        retry_send_stream = true;
+        s_retried_requests ++;
+        is_done = false;
       }
     }
-    return sent;
+    if (is_done) m_issue_random = true;
   }
 
   // regulate the bandwidth by inserting a number of NOP operations
@@ -318,20 +572,34 @@ class MessReqGenerator : public IFrontEnd, public Implementation {
     return res;
   }
 
-  bool can_issue_random_req() {
-    if (m_last_random_req.addr == -1) 
+  bool is_chain_ready(const ChaseChain& chain) {
+    if (chain.last_req.addr == -1) 
       return true;
-    else if (m_memory_system->is_request_finished(m_last_random_req)) 
+    else if (m_memory_system->is_request_finished(chain.last_req)) 
       return true;
     return false;
   }
 
+  bool can_issue_random_req() {
+    for (const auto& chain : m_chains) {
+      if (chain.is_pending || is_chain_ready(chain)) return true;
+    }
+    return false;
+  }
+
+  void print_progress() {
+    if ((m_frontend_ticks % 100000) == 0) {
+      std::cout << "Frontend: tick " << m_frontend_ticks << ", issued " << random_count << "/" << m_total_requests << "random requests" << std::endl;
+    }
+  }
+
   void tick() override {
     // add this line to only issue stream requests -> must terminate run manually & stats are wrong btw
     //m_issue_random = false;
-    if ((m_frontend_ticks % 100000) == 0) {
-      std::cout << "Frontend: tick " << m_frontend_ticks << ", issued " << random_count << "/" << m_total_requests << "random requests" << std::endl;
+    if (m_target_bandwidth > 0 && static_cast<Clk_t>(m_frontend_ticks) >= m_next_control_tick) {
+      update_issue_rate();
     }
+    print_progress();
     m_frontend_ticks++;
 
     bool idle = is_idle_tick();
@@ -341,23 +609,93 @@ class MessReqGenerator : public IFrontEnd, public Implementation {
       return;
     }
 
-    // make sure random requests are issued sequentially
+    // make sure the requests of each chain are issued sequentially
     if (m_issue_random && !can_issue_random_req()) {
-      //std::cout << "waiting for req to addr " << m_last_random_req.addr << " to finish" << std::endl;
       s_total_number_for_idle_ticks_random_reads ++;
       m_issue_random = false;
       return;
     }
-      
-    bool request_sent = issue_request();
-    if (request_sent) {
-      m_issued_requests++;
-      update_stats(); 
-    } else {
-      s_retried_requests ++; 
-    }
+
+    if (m_issue_random)
+      issue_random_requests();
+    else
+      issue_stream_requests();
   };
 
+  // the next tick that sends a request to the memory system or adjusts the NOP counter (in frontend ticks)
+  Clk_t get_next_event_cycle() override {
+    Clk_t next_issue_cycle = get_next_issue_cycle();
+    if (m_target_bandwidth > 0 && next_issue_cycle != NEVER_CLK)
+      return std::min(next_issue_cycle, m_next_control_tick + 1);
+    return next_issue_cycle;
+  }
+
+  Clk_t get_next_issue_cycle() {
+    // all requests issued: the next tick is only interesting if it ends the simulation,
+    // which in turn only changes when the memory system drains its queues
+    if (random_count >= m_total_requests)
+      return is_finished() ? m_frontend_ticks + 1 : NEVER_CLK;
+
+    if (m_issue_random) {
+      if (can_issue_random_req()) 
+        return m_frontend_ticks + 1;
+      // the blocked chase request gives up this tick and we fall back to stream mode
+      return m_frontend_ticks + 1 + get_next_stream_tick(m_curr_nop_counter);
+    }
+
+    if (m_curr_nop_counter == 0) 
+      return m_frontend_ticks + 1;
+    // one idle tick, then we try the pointer chase
+    if (can_issue_random_req()) 
+      return m_frontend_ticks + 2;
+    return m_frontend_ticks + get_next_stream_tick(m_curr_nop_counter);
+  }
+
+  // number of ticks until a stream request is issued from stream mode with the given NOP counter,
+  // assuming the pointer chase stays blocked (idle and blocked ticks alternate until the counter wraps)
+  Clk_t get_next_stream_tick(size_t nop_counter) {
+    if (nop_counter == 0) 
+      return 1;
+    return 2 * (m_nop_counter - nop_counter) + 1;
+  }
+
+  // replays the ticks before get_next_event_cycle(), none of which send a request
+  void fast_forward(Clk_t num_cycles) override {
+    for (Clk_t i = 0; i < num_cycles; i++) {
+      print_progress();
+      m_frontend_ticks++;
+
+      bool idle = is_idle_tick();
+      if (idle || (random_count >= m_total_requests)) {
+        m_issue_random = !m_issue_random;
+        continue;
+      }
+
+      // the only non-idle tick that sends nothing is a blocked pointer chase
+      s_total_number_for_idle_ticks_random_reads ++;
+      m_issue_random = false;
+    }
+  }
+
+  void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override {
+    // the column bits start right above the transaction offset
+    m_transaction_bytes = 1LL << m_memory_system->get_shift_amt(4);
+    m_tick_ns = m_memory_system->get_tCK() * m_memory_system->get_clock_ratio() / m_clock_ratio;
+
+    if (m_target_bandwidth > 0) {
+      // start from the NOP counter that reaches the target if every stream turn (every other tick) sends to all channels
+      double max_bandwidth = get_bandwidth(m_memory_system->get_num_channels() * m_streams.size(), 2);
+      m_nop_target = std::clamp(max_bandwidth / m_target_bandwidth, 1.0, MaxNopCounter);
+      set_nop_counter();
+      m_next_control_tick = m_control_epoch;
+    }
+  }
+
+  void finalize() override {
+    s_achieved_bandwidth = get_bandwidth(s_num_transactions, m_frontend_ticks);
+    IFrontEnd::finalize();
+  }
+
   //bool is_finished() override { return (m_issued_requests >= m_total_requests && m_memory_system->is_finished_ms()); };
 
   // alternative is_finished that looks at only random request counts
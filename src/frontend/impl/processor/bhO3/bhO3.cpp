@@ -19,11 +19,11 @@ void BHO3::init() {
   std::vector<std::string> no_wait_trace_list = param<std::vector<std::string>>("no_wait_traces").desc("Traces that do not block program termination.").default_val(empty_trace);
   m_num_cores = trace_list.size() + no_wait_trace_list.size();
   m_num_blocking_cores = trace_list.size();
+  bool trace_streaming = param<bool>("trace_streaming").desc("Whether to stream the traces from the files instead of loading them into memory. Compressed traces are always streamed.").default_val(false);
 
   int ipc   = param<int>("ipc").desc("IPC of the SimpleO3 core.").default_val(4);
   int depth = param<int>("inst_window_depth").desc("Instruction window size of the SimpleO3 core.").default_val(128);
 
-  int lat_hist_sensitivity = param<int>("lat_hist_sensitivity").default_val(5);
   std::string lat_dump_path = param<std::string>("lat_dump_path").default_val(std::string(""));
 
   // LLC params
@@ -65,8 +65,8 @@ void BHO3::init() {
     // auto* cur_translate = m_translation;
     std::cout << "name_trace_" << id << ": " << active_list[active_id] << std::endl;
     BHO3Core* core = new BHO3Core(id, ipc, depth,
-      m_num_expected_insts, m_num_max_cycles, active_list[active_id],
-      cur_translate, m_llc, lat_hist_sensitivity, lat_dump_path, is_attacker);
+      m_num_expected_insts, m_num_max_cycles, active_list[active_id], trace_streaming,
+      cur_translate, m_llc, lat_dump_path, is_attacker);
     core->m_callback = [this](Request& req){return this->receive(req);} ;
     m_cores.push_back(core);
   }
@@ -88,6 +88,7 @@ void BHO3::init() {
     register_stat(m_cores[core_id]->s_insts_recorded).name("insts_recorded_core_{}", core_id);
     register_stat(m_cores[core_id]->s_mem_access_cycles).name("memory_access_cycles_recorded_core_{}", core_id);
     register_stat(m_cores[core_id]->s_mem_requests_issued).name("memory_requests_recorded_core_{}", core_id);
+    register_stat(m_cores[core_id]->s_mem_access_latency).name("memory_access_latency_core_{}", core_id);
   }
 }
 
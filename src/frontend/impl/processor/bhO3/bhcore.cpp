@@ -13,46 +13,12 @@ namespace Ramulator {
 
 namespace fs = std::filesystem;
 
-BHO3Core::Trace::Trace(std::string file_path_str) {
-  fs::path trace_path(file_path_str);
-  if (!fs::exists(trace_path)) {
-    throw ConfigurationError("Trace {} does not exist!", file_path_str);
-  }
-
-  std::ifstream trace_file(trace_path);
-  if (!trace_file.is_open()) {
-    throw ConfigurationError("Trace {} cannot be opened!", file_path_str);
-  }
-
-  std::string line;
-  while (std::getline(trace_file, line)) {
-    std::vector<std::string> tokens;
-    tokenize(tokens, line, " ");
-
-    int num_tokens = tokens.size();
-    if (num_tokens != 2 & num_tokens != 3) {
-      throw ConfigurationError("Trace {} format invalid!", file_path_str);
-    }
-    int bubble_count = std::stoi(tokens[0]);
-    Addr_t load_addr = std::stoll(tokens[1]);
-
-    bool has_store = num_tokens == 2 ? false : true; 
-    if (has_store) {
-      Addr_t store_addr = std::stoll(tokens[2]);
-      m_trace.push_back({bubble_count, load_addr, store_addr});
-    } else {
-      m_trace.push_back({bubble_count, load_addr, -1});
-    }
-  }
-
-  trace_file.close();
-  m_trace_length = m_trace.size();
+BHO3Core::Trace::Trace(std::string file_path_str, bool streaming) {
+  m_trace = open_inst_trace(file_path_str, streaming);
 }
 
 const BHO3Core::Inst& BHO3Core::Trace::get_next_inst() {
-  const Inst& inst = m_trace[m_curr_trace_idx];
-  m_curr_trace_idx = (m_curr_trace_idx + 1) % m_trace_length;
-  return inst;
+  return *m_trace.next();
 }
 
 BHO3Core::InstWindow::InstWindow(int ipc, int depth):
@@ -108,17 +74,17 @@ Clk_t BHO3Core::InstWindow::set_ready(Addr_t addr) {
 }
 
 BHO3Core::BHO3Core(int id, int ipc, int depth, size_t num_expected_insts,
-  uint64_t num_max_cycles, std::string trace_path, ITranslation* translation,
-  BHO3LLC* llc, int lat_hist_sens, std::string& dump_path, bool is_attacker):
-m_id(id), m_window(ipc, depth), m_trace(trace_path),
+  uint64_t num_max_cycles, std::string trace_path, bool trace_streaming, ITranslation* translation,
+  BHO3LLC* llc, std::string& dump_path, bool is_attacker):
+m_id(id), m_window(ipc, depth), m_trace(trace_path, trace_streaming),
 m_num_expected_insts(num_expected_insts), m_num_max_cycles(num_max_cycles), m_translation(translation),
-m_llc(llc), m_lat_hist_sens(lat_hist_sens), m_is_attacker(is_attacker) {
+m_llc(llc), m_is_attacker(is_attacker) {
   // Fetch the instructions and addresses for tick 0
   auto inst = m_trace.get_next_inst();
   m_num_bubbles = inst.bubble_count;
   m_load_addr = inst.load_addr;
   m_writeback_addr = inst.store_addr;
-  if (m_dump_path == "") {
+  if (dump_path == "") {
     return;
   }
   m_dump_path = fmt::format("{}.core{}", dump_path, id);
@@ -213,11 +179,7 @@ void BHO3Core::receive(Request& req) {
   if (!reached_expected_num_insts && depart != std::numeric_limits<Clk_t>::max()) {
     s_mem_access_cycles += req_duration;
     m_last_mem_cycle = depart;
-    int lat_bucket = req_duration - (req_duration % m_lat_hist_sens);
-    if (m_lat_histogram.find(lat_bucket) == m_lat_histogram.end()) {
-      m_lat_histogram[lat_bucket] = 0;
-    }
-    m_lat_histogram[lat_bucket]++;
+    s_mem_access_latency.record(req_duration);
   }
 
   if (m_is_attacker) {
@@ -230,9 +192,9 @@ void BHO3Core::dump_latency_histogram() {
     return;
   }
   std::ofstream output(m_dump_path);
-  for (const auto& [bucket_base, count] : m_lat_histogram) {
-    output << fmt::format("{}, {}", bucket_base, count) << std::endl;
-  }
+  s_mem_access_latency.for_each_bucket([&output](uint64_t lower, uint64_t upper, uint64_t count) {
+    output << fmt::format("{}, {}", lower, count) << std::endl;
+  });
   output.close();
 }
 
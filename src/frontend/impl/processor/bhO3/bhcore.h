@@ -8,8 +8,10 @@
 #include <fstream>
 
 #include "base/type.h"
+#include "base/histogram.h"
 #include "base/request.h"
 #include "translation/translation.h"
+#include "frontend/trace_stream.h"
 
 namespace Ramulator {
 
@@ -17,21 +19,15 @@ class BHO3LLC;
 
 class BHO3Core: public Clocked<BHO3Core> {
   friend class BHO3;
-  struct Inst {
-    int bubble_count = 0;
-    Addr_t load_addr = -1;
-    Addr_t store_addr = -1;
-  };
+  using Inst = InstRecord;
   
   class Trace {
     friend class BHO3Core;
 
-    std::vector<Inst> m_trace;
-    size_t m_trace_length = 0;
-    size_t m_curr_trace_idx = 0;
+    TraceReader<Inst> m_trace;
 
     public:
-      Trace(std::string file_path_str);
+      Trace(std::string file_path_str, bool streaming);
       const Inst& get_next_inst();
   };
 
@@ -90,7 +86,7 @@ class BHO3Core: public Clocked<BHO3Core> {
     ITranslation* m_translation;
     BHO3LLC* m_llc;
 
-    std::function<void(Request&)> m_callback;
+    Request::Callback_t m_callback;
 
     int    m_num_bubbles = 0;
     Addr_t m_load_addr = -1;
@@ -99,8 +95,6 @@ class BHO3Core: public Clocked<BHO3Core> {
     size_t m_num_expected_insts = 0;  
     uint64_t m_num_max_cycles = 0;
     Clk_t m_last_mem_cycle = 0; // The last cycle that a memory request departs from mc
-    int m_lat_hist_sens = 0;
-    std::unordered_map<int, uint64_t> m_lat_histogram;
     std::filesystem::path m_dump_path;
 
     bool m_is_attacker = false;
@@ -117,11 +111,12 @@ class BHO3Core: public Clocked<BHO3Core> {
     size_t s_insts_recorded = 0;
     Clk_t  s_mem_access_cycles = 0; 
     size_t s_mem_requests_issued = 0;
+    LatencyHistogram s_mem_access_latency;
 
   public:
     BHO3Core(int id, int ipc, int depth,
-      size_t num_expected_insts, uint64_t num_max_cycles, std::string trace_path,
-      ITranslation* translation, BHO3LLC* llc, int lat_hist_sens, std::string& dump_path, bool is_attacker);
+      size_t num_expected_insts, uint64_t num_max_cycles, std::string trace_path, bool trace_streaming,
+      ITranslation* translation, BHO3LLC* llc, std::string& dump_path, bool is_attacker);
 
     /**
      * @brief   Ticks the core.
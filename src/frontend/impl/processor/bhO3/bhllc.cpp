@@ -80,7 +80,7 @@ bool BHO3LLC::send(Request& req) {
     set.erase(line_it);
 
     // Add to the hit list to callback when finished
-    m_hit_list.push_back(std::make_pair(m_clk + m_latency, req));
+    m_hit_list.push_back(std::make_pair(m_clk + m_latency, std::move(req)));
     return true;
   } else {
     // Miss in the set
@@ -105,7 +105,7 @@ bool BHO3LLC::send(Request& req) {
     if (mshr_it != m_mshrs.end()) {
       DEBUG_LOG(DBHO3LLC, m_logger,  "MSHR Hit.", m_clk);
       // Add new req to MSHR_requests
-      m_receive_requests[mshr_it->first].push_back(req);
+      m_receive_requests[mshr_it->first].push_back(std::move(req));
 
       mshr_it->second->dirty = dirty || mshr_it->second->dirty;
       return true;
@@ -13,46 +13,12 @@ namespace Ramulator {
 
 namespace fs = std::filesystem;
 
-SimpleO3Core::Trace::Trace(std::string file_path_str) {
-  fs::path trace_path(file_path_str);
-  if (!fs::exists(trace_path)) {
-    throw ConfigurationError("Trace {} does not exist!", file_path_str);
-  }
-
-  std::ifstream trace_file(trace_path);
-  if (!trace_file.is_open()) {
-    throw ConfigurationError("Trace {} cannot be opened!", file_path_str);
-  }
-
-  std::string line;
-  while (std::getline(trace_file, line)) {
-    std::vector<std::string> tokens;
-    tokenize(tokens, line, " ");
-
-    int num_tokens = tokens.size();
-    if (num_tokens != 2 & num_tokens != 3) {
-      throw ConfigurationError("Trace {} format invalid!", file_path_str);
-    }
-    int bubble_count = std::stoi(tokens[0]);
-    Addr_t load_addr = std::stoll(tokens[1]);
-
-    bool has_store = num_tokens == 2 ? false : true; 
-    if (has_store) {
-      Addr_t store_addr = std::stoll(tokens[2]);
-      m_trace.push_back({bubble_count, load_addr, store_addr});
-    } else {
-      m_trace.push_back({bubble_count, load_addr, -1});
-    }
-  }
-
-  trace_file.close();
-  m_trace_length = m_trace.size();
+SimpleO3Core::Trace::Trace(std::string file_path_str, bool streaming) {
+  m_trace = open_inst_trace(file_path_str, streaming);
 }
 
 const SimpleO3Core::Trace::Inst& SimpleO3Core::Trace::get_next_inst() {
-  const Inst& inst = m_trace[m_curr_trace_idx];
-  m_curr_trace_idx = (m_curr_trace_idx + 1) % m_trace_length;
-  return inst;
+  return *m_trace.next();
 }
 
 
@@ -102,8 +68,8 @@ void SimpleO3Core::InstWindow::set_ready(Addr_t addr) {
   }
 }
 
-SimpleO3Core::SimpleO3Core(int id, int ipc, int depth, size_t num_expected_insts, std::string trace_path, ITranslation* translation, SimpleO3LLC* llc):
-m_id(id), m_window(ipc, depth), m_trace(trace_path), m_num_expected_insts(num_expected_insts), m_translation(translation), m_llc(llc) {
+SimpleO3Core::SimpleO3Core(int id, int ipc, int depth, size_t num_expected_insts, std::string trace_path, bool trace_streaming, ITranslation* translation, SimpleO3LLC* llc):
+m_id(id), m_window(ipc, depth), m_trace(trace_path, trace_streaming), m_num_expected_insts(num_expected_insts), m_translation(translation), m_llc(llc) {
   // Fetch the instructions and addresses for tick 0
   auto inst = m_trace.get_next_inst();
   m_num_bubbles = inst.bubble_count;
@@ -181,6 +147,21 @@ void SimpleO3Core::tick() {
   m_writeback_addr = inst.store_addr;      
 }
 
+Clk_t SimpleO3Core::get_next_event_cycle() {
+  // The core is stalled if it can neither retire the tail instruction nor insert the next one.
+  // Only receive() (i.e., the LLC or the memory system) can change that.
+  bool is_retire_stalled = !m_window.m_ready_list[m_window.m_tail_idx];
+  bool is_insert_stalled = m_window.is_full() && (m_num_bubbles > 0 || m_load_addr != -1);
+  if (is_retire_stalled && is_insert_stalled) {
+    return NEVER_CLK;
+  }
+  return m_clk + 1;
+}
+
+void SimpleO3Core::fast_forward(Clk_t num_cycles) {
+  m_clk += num_cycles;
+}
+
 void SimpleO3Core::receive(Request& req) {
   m_window.set_ready(req.addr);
 
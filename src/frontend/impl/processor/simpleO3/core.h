@@ -8,6 +8,7 @@
 #include "base/type.h"
 #include "base/request.h"
 #include "translation/translation.h"
+#include "frontend/trace_stream.h"
 
 namespace Ramulator {
 
@@ -17,18 +18,12 @@ class SimpleO3Core : public Clocked<SimpleO3Core> {
   friend class SimpleO3;
   class Trace {
     friend class SimpleO3Core;
-    struct Inst {
-      int bubble_count = 0;
-      Addr_t load_addr = -1;
-      Addr_t store_addr = -1;
-    };
-  
-    std::vector<Inst> m_trace;
-    size_t m_trace_length = 0;
-    size_t m_curr_trace_idx = 0;
+    using Inst = InstRecord;
+
+    TraceReader<Inst> m_trace;
 
     public:
-      Trace(std::string file_path_str);
+      Trace(std::string file_path_str, bool streaming);
       const Inst& get_next_inst();
   };
 
@@ -86,7 +81,7 @@ class SimpleO3Core : public Clocked<SimpleO3Core> {
     ITranslation* m_translation;
     SimpleO3LLC* m_llc;
 
-    std::function<void(Request&)> m_callback;
+    Request::Callback_t m_callback;
 
     int    m_num_bubbles = 0;
     Addr_t m_load_addr = -1;
@@ -105,7 +100,7 @@ class SimpleO3Core : public Clocked<SimpleO3Core> {
     Clk_t  s_mem_access_cycles = 0; 
 
   public:
-    SimpleO3Core(int id, int ipc, int depth, size_t num_expected_insts, std::string trace_path, ITranslation* translation, SimpleO3LLC* llc);
+    SimpleO3Core(int id, int ipc, int depth, size_t num_expected_insts, std::string trace_path, bool trace_streaming, ITranslation* translation, SimpleO3LLC* llc);
 
     /**
      * @brief   Ticks the core.
@@ -113,6 +108,18 @@ class SimpleO3Core : public Clocked<SimpleO3Core> {
      */
     void tick() override;
 
+    /**
+     * @brief   Returns NEVER_CLK if the core is stalled on a full window until a memory request is served.
+     * 
+     */
+    Clk_t get_next_event_cycle() override;
+
+    /**
+     * @brief   Advances the clock of a stalled core.
+     * 
+     */
+    void fast_forward(Clk_t num_cycles) override;
+
     /**
      * @brief   Called when a request is served by the memory.
      * 
@@ -52,6 +52,22 @@ void SimpleO3LLC::tick() {
   }
 };
 
+Clk_t SimpleO3LLC::get_next_event_cycle() {
+  // The earliest miss to send or hit to call back (a miss that the memory system rejected is retried every cycle)
+  Clk_t next_event_cycle = NEVER_CLK;
+  for (const auto& [clk, req] : m_miss_list) {
+    next_event_cycle = std::min(next_event_cycle, std::max(clk, m_clk + 1));
+  }
+  for (const auto& [clk, req] : m_hit_list) {
+    next_event_cycle = std::min(next_event_cycle, std::max(clk, m_clk + 1));
+  }
+  return next_event_cycle;
+};
+
+void SimpleO3LLC::fast_forward(Clk_t num_cycles) {
+  m_clk += num_cycles;
+};
+
 bool SimpleO3LLC::send(Request req) {
   CacheSet_t& set = get_set(req.addr);
 
@@ -73,7 +89,7 @@ bool SimpleO3LLC::send(Request req) {
     set.erase(line_it);
 
     // Add to the hit list to callback when finished
-    m_hit_list.push_back(std::make_pair(m_clk + m_latency, req));
+    m_hit_list.push_back(std::make_pair(m_clk + m_latency, std::move(req)));
     return true;
   } else {
     // Miss in the set
@@ -98,7 +114,7 @@ bool SimpleO3LLC::send(Request req) {
     if (mshr_it != m_mshrs.end()) {
       DEBUG_LOG(DSIMPLEO3LLC, m_logger,  "MSHR Hit.", m_clk);
       // Add new req to MSHR_requests
-      m_receive_requests[mshr_it->first].push_back(req);
+      m_receive_requests[mshr_it->first].push_back(std::move(req));
 
       mshr_it->second->dirty = dirty || mshr_it->second->dirty;
       return true;
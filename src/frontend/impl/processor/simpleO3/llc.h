@@ -76,6 +76,8 @@ class SimpleO3LLC : public Clocked<SimpleO3LLC> {
     void connect_memory_system(IMemorySystem* memory_system) { m_memory_system = memory_system; };
     
     void tick();
+    Clk_t get_next_event_cycle() override;
+    void fast_forward(Clk_t num_cycles) override;
     bool send(Request req);
     void receive(Request& req);
 
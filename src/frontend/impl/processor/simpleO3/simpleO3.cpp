@@ -31,6 +31,7 @@ class SimpleO3 final : public IFrontEnd, public Implementation {
       // Core params
       std::vector<std::string> trace_list = param<std::vector<std::string>>("traces").desc("A list of traces.").required();
       m_num_cores = trace_list.size();
+      bool trace_streaming = param<bool>("trace_streaming").desc("Whether to stream the traces from the files instead of loading them into memory. Compressed traces are always streamed.").default_val(false);
 
       int ipc   = param<int>("ipc").desc("IPC of the SimpleO3 core.").default_val(4);
       int depth = param<int>("inst_window_depth").desc("Instruction window size of the SimpleO3 core.").default_val(128);
@@ -55,7 +56,7 @@ class SimpleO3 final : public IFrontEnd, public Implementation {
 
       // Create the cores
       for (int id = 0; id < m_num_cores; id++) {
-        SimpleO3Core* core = new SimpleO3Core(id, ipc, depth, m_num_expected_insts, trace_list[id], m_translation, m_llc);
+        SimpleO3Core* core = new SimpleO3Core(id, ipc, depth, m_num_expected_insts, trace_list[id], trace_streaming, m_translation, m_llc);
         core->m_callback = [this](Request& req){return this->receive(req);} ;
         m_cores.push_back(core);
       }
@@ -91,6 +92,27 @@ class SimpleO3 final : public IFrontEnd, public Implementation {
       }
     }
 
+    Clk_t get_next_event_cycle() override {
+      Clk_t next_event_cycle = m_llc->get_next_event_cycle();
+      for (auto core : m_cores) {
+        next_event_cycle = std::min(next_event_cycle, core->get_next_event_cycle());
+      }
+      return next_event_cycle;
+    }
+
+    void fast_forward(Clk_t num_cycles) override {
+      // Keep the heartbeat of the skipped cycles
+      for (Clk_t clk = (m_clk / 10000000 + 1) * 10000000; clk <= m_clk + num_cycles; clk += 10000000) {
+        m_logger->info("Processor Heartbeat {} cycles.", clk);
+      }
+      m_clk += num_cycles;
+
+      m_llc->fast_forward(num_cycles);
+      for (auto core : m_cores) {
+        core->fast_forward(num_cycles);
+      }
+    }
+
     void receive(Request& req) {
       m_llc->receive(req);
 
@@ -0,0 +1,310 @@
+#include <fstream>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <spdlog/spdlog.h>
+
+#include "base/exception.h"
+#include "base/utils.h"
+#include "frontend/trace_file.h"
+
+namespace Ramulator {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+std::ifstream open_text_trace(const fs::path& path) {
+  if (!fs::exists(path)) {
+    throw ConfigurationError("Trace {} does not exist!", path.string());
+  }
+  std::ifstream trace_file(path);
+  if (!trace_file.is_open()) {
+    throw ConfigurationError("Trace {} cannot be opened!", path.string());
+  }
+  return trace_file;
+}
+
+size_t get_record_size(TraceKind kind, size_t num_fields) {
+  switch (kind) {
+    case TraceKind::LoadStore: return sizeof(LoadStoreRecord);
+    case TraceKind::ReadWrite: return (num_fields + 1) * sizeof(int32_t);
+    case TraceKind::Inst:      return sizeof(InstRecord);
+  }
+  return 0;
+}
+
+template <typename T>
+void check_not_empty(const TraceBuffer<T>& trace, const fs::path& path) {
+  if (trace.size() == 0) {
+    throw ConfigurationError("Trace {} is empty!", path.string());
+  }
+}
+
+void write_binary_trace(const fs::path& path, TraceKind kind, size_t num_fields, size_t num_records, const void* records) {
+  if (path.has_parent_path()) {
+    fs::create_directories(path.parent_path());
+  }
+  std::ofstream output(path, std::ios::binary);
+  if (!output.is_open()) {
+    throw ConfigurationError("Cannot open binary trace {}!", path.string());
+  }
+
+  TraceHeader header;
+  std::memcpy(header.magic, TraceHeader::Magic, sizeof(header.magic));
+  header.version = TraceHeader::Version;
+  header.kind = static_cast<uint32_t>(kind);
+  header.record_size = get_record_size(kind, num_fields);
+  header.num_fields = num_fields;
+  header.num_records = num_records;
+  output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  output.write(reinterpret_cast<const char*>(records), num_records * header.record_size);
+  if (!output.good()) {
+    throw ConfigurationError("Failed to write binary trace {}!", path.string());
+  }
+}
+
+}        // namespace
+
+
+std::string check_trace_header(const TraceHeader& header, TraceKind kind) {
+  if (std::memcmp(header.magic, TraceHeader::Magic, sizeof(TraceHeader::Magic)) != 0) {
+    return "not a binary trace";
+  } else if (header.version != TraceHeader::Version) {
+    return fmt::format("version {} (expected {})", header.version, TraceHeader::Version);
+  } else if (header.kind != static_cast<uint32_t>(kind)) {
+    return fmt::format("kind {} (expected {})", header.kind, static_cast<uint32_t>(kind));
+  } else if (header.record_size != get_record_size(kind, header.num_fields)) {
+    return fmt::format("records of {} bytes (expected {})", header.record_size, get_record_size(kind, header.num_fields));
+  }
+  return "";
+}
+
+MappedTrace::MappedTrace(const fs::path& path, TraceKind kind) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw ConfigurationError("Trace {} cannot be opened!", path.string());
+  }
+  struct stat file_stat;
+  if (::fstat(fd, &file_stat) != 0 || static_cast<size_t>(file_stat.st_size) < sizeof(TraceHeader)) {
+    ::close(fd);
+    throw ConfigurationError("Binary trace {} is truncated!", path.string());
+  }
+  m_size = file_stat.st_size;
+  m_data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (m_data == MAP_FAILED) {
+    m_data = nullptr;
+    throw ConfigurationError("Binary trace {} cannot be mapped!", path.string());
+  }
+  // The records are read once from front to back
+  ::madvise(m_data, m_size, MADV_SEQUENTIAL);
+
+  m_header = reinterpret_cast<const TraceHeader*>(m_data);
+  std::string error = check_trace_header(*m_header, kind);
+  if (error.empty() && m_size < sizeof(TraceHeader) + m_header->num_records * m_header->record_size) {
+    error = "the trace is truncated";
+  }
+  if (!error.empty()) {
+    // The destructor does not run when the constructor throws
+    ::munmap(m_data, m_size);
+    m_data = nullptr;
+    throw ConfigurationError("Binary trace {} is invalid: {}!", path.string(), error);
+  }
+}
+
+MappedTrace::~MappedTrace() {
+  if (m_data != nullptr) {
+    ::munmap(m_data, m_size);
+  }
+}
+
+bool MappedTrace::is_binary_trace(const fs::path& path) {
+  std::ifstream file(path, std::ios::binary);
+  char magic[sizeof(TraceHeader::Magic)] = {};
+  file.read(magic, sizeof(magic));
+  return file.gcount() == sizeof(magic) && std::memcmp(magic, TraceHeader::Magic, sizeof(magic)) == 0;
+}
+
+
+bool parse_loadstore_line(const std::string& line, LoadStoreRecord& record) {
+  std::vector<std::string> tokens;
+  tokenize(tokens, line, " ");
+  if (tokens.size() != 2) {
+    return false;
+  }
+
+  if (tokens[0] == "LD") {
+    record.is_write = false;
+  } else if (tokens[0] == "ST") {
+    record.is_write = true;
+  } else {
+    return false;
+  }
+
+  if (tokens[1].compare(0, 2, "0x") == 0 || tokens[1].compare(0, 2, "0X") == 0) {
+    record.addr = std::stoll(tokens[1].substr(2), nullptr, 16);
+  } else {
+    record.addr = std::stoll(tokens[1]);
+  }
+  return true;
+}
+
+bool parse_readwrite_line(const std::string& line, std::vector<int32_t>& values) {
+  std::vector<std::string> tokens;
+  tokenize(tokens, line, " ");
+  if (tokens.size() != 2) {
+    return false;
+  }
+
+  if (tokens[0] == "R") {
+    values.push_back(0);
+  } else if (tokens[0] == "W") {
+    values.push_back(1);
+  } else {
+    return false;
+  }
+
+  std::vector<std::string> addr_vec_tokens;
+  tokenize(addr_vec_tokens, tokens[1], ",");
+  for (const auto& token : addr_vec_tokens) {
+    values.push_back(std::stoi(token));
+  }
+  return true;
+}
+
+bool parse_inst_line(const std::string& line, InstRecord& record) {
+  std::vector<std::string> tokens;
+  tokenize(tokens, line, " ");
+
+  int num_tokens = tokens.size();
+  if (num_tokens != 2 && num_tokens != 3) {
+    return false;
+  }
+  record.bubble_count = std::stoi(tokens[0]);
+  record.load_addr = std::stoll(tokens[1]);
+
+  bool has_store = num_tokens == 2 ? false : true;
+  record.store_addr = has_store ? std::stoll(tokens[2]) : -1;
+  return true;
+}
+
+
+std::vector<LoadStoreRecord> parse_loadstore_trace(const fs::path& path) {
+  std::ifstream trace_file = open_text_trace(path);
+  std::vector<LoadStoreRecord> records;
+
+  std::string line;
+  size_t line_number = 0;
+  while (std::getline(trace_file, line)) {
+    line_number++;
+    LoadStoreRecord record;
+    if (!parse_loadstore_line(line, record)) {
+      throw ConfigurationError("Trace {} format invalid at line {}!", path.string(), line_number);
+    }
+    records.push_back(record);
+  }
+  return records;
+}
+
+std::vector<int32_t> parse_readwrite_trace(const fs::path& path, size_t& num_fields) {
+  std::ifstream trace_file = open_text_trace(path);
+  std::vector<int32_t> values;
+  num_fields = 0;
+
+  std::string line;
+  size_t line_number = 0;
+  while (std::getline(trace_file, line)) {
+    line_number++;
+    size_t num_values = values.size();
+    if (!parse_readwrite_line(line, values)) {
+      throw ConfigurationError("Trace {} format invalid at line {}!", path.string(), line_number);
+    }
+    size_t line_num_fields = values.size() - num_values - 1;
+    if (line_number == 1) {
+      num_fields = line_num_fields;
+    } else if (line_num_fields != num_fields) {
+      throw ConfigurationError("Trace {} has an address vector of {} levels at line {} (expected {})!", path.string(), line_num_fields, line_number, num_fields);
+    }
+  }
+  return values;
+}
+
+std::vector<InstRecord> parse_inst_trace(const fs::path& path) {
+  std::ifstream trace_file = open_text_trace(path);
+  std::vector<InstRecord> records;
+
+  std::string line;
+  size_t line_number = 0;
+  while (std::getline(trace_file, line)) {
+    line_number++;
+    InstRecord record;
+    if (!parse_inst_line(line, record)) {
+      throw ConfigurationError("Trace {} format invalid at line {}!", path.string(), line_number);
+    }
+    records.push_back(record);
+  }
+  return records;
+}
+
+
+TraceBuffer<LoadStoreRecord> load_loadstore_trace(const fs::path& path) {
+  TraceBuffer<LoadStoreRecord> trace;
+  if (MappedTrace::is_binary_trace(path)) {
+    trace = TraceBuffer<LoadStoreRecord>(std::make_unique<MappedTrace>(path, TraceKind::LoadStore));
+  } else {
+    trace = TraceBuffer<LoadStoreRecord>(parse_loadstore_trace(path));
+  }
+  check_not_empty(trace, path);
+  return trace;
+}
+
+TraceBuffer<int32_t> load_readwrite_trace(const fs::path& path, size_t& num_fields) {
+  TraceBuffer<int32_t> trace;
+  if (MappedTrace::is_binary_trace(path)) {
+    auto mapped = std::make_unique<MappedTrace>(path, TraceKind::ReadWrite);
+    num_fields = mapped->get_header().num_fields;
+    trace = TraceBuffer<int32_t>(std::move(mapped), num_fields + 1);
+  } else {
+    trace = TraceBuffer<int32_t>(parse_readwrite_trace(path, num_fields));
+  }
+  check_not_empty(trace, path);
+  return trace;
+}
+
+TraceBuffer<InstRecord> load_inst_trace(const fs::path& path) {
+  TraceBuffer<InstRecord> trace;
+  if (MappedTrace::is_binary_trace(path)) {
+    trace = TraceBuffer<InstRecord>(std::make_unique<MappedTrace>(path, TraceKind::Inst));
+  } else {
+    trace = TraceBuffer<InstRecord>(parse_inst_trace(path));
+  }
+  check_not_empty(trace, path);
+  return trace;
+}
+
+
+size_t convert_trace(const std::string& kind_name, const fs::path& input_path, const fs::path& output_path) {
+  if (kind_name == "loadstore") {
+    auto records = parse_loadstore_trace(input_path);
+    write_binary_trace(output_path, TraceKind::LoadStore, 0, records.size(), records.data());
+    return records.size();
+  } else if (kind_name == "readwrite") {
+    size_t num_fields = 0;
+    auto values = parse_readwrite_trace(input_path, num_fields);
+    size_t num_records = values.size() / (num_fields + 1);
+    write_binary_trace(output_path, TraceKind::ReadWrite, num_fields, num_records, values.data());
+    return num_records;
+  } else if (kind_name == "inst") {
+    auto records = parse_inst_trace(input_path);
+    write_binary_trace(output_path, TraceKind::Inst, 0, records.size(), records.data());
+    return records.size();
+  }
+  throw ConfigurationError("Unrecognized trace kind \"{}\" (expected loadstore, readwrite, or inst)!", kind_name);
+}
+
+}        // namespace Ramulator
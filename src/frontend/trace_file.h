@@ -0,0 +1,164 @@
+#ifndef     RAMULATOR_FRONTEND_TRACE_FILE_H
+#define     RAMULATOR_FRONTEND_TRACE_FILE_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <span>
+#include <cstdint>
+#include <filesystem>
+
+#include "base/type.h"
+
+namespace Ramulator {
+
+/**
+ * @brief     The kinds of traces read by the trace frontends.
+ * @details
+ *  - LoadStore (LoadStoreTrace):   "LD|ST <addr>"
+ *  - ReadWrite (ReadWriteTrace):   "R|W <addr_vec[0]>,<addr_vec[1]>,..."
+ *  - Inst (SimpleO3 and BHO3):     "<num_non_memory_insts> <load_addr> [writeback_addr]"
+ *
+ */
+enum class TraceKind : uint32_t {
+  LoadStore = 0,
+  ReadWrite = 1,
+  Inst      = 2,
+};
+
+/**
+ * @brief     Header of a binary trace, followed by num_records records of record_size bytes.
+ * @details
+ * LoadStore and Inst records are LoadStoreRecord and InstRecord. A ReadWrite record is num_fields + 1 int32: the
+ * first is 1 for writes and 0 for reads, the rest are the address vector. All values are little-endian.
+ *
+ */
+struct TraceHeader {
+  static constexpr char Magic[8] = {'R', 'A', 'M', 'T', 'R', 'A', 'C', 'E'};
+  static constexpr uint32_t Version = 1;
+
+  char magic[8];
+  uint32_t version;
+  uint32_t kind;
+  uint32_t record_size;
+  uint32_t num_fields;      // The length of the address vectors of ReadWrite traces, 0 otherwise
+  uint64_t num_records;
+};
+static_assert(sizeof(TraceHeader) == 32);
+
+struct LoadStoreRecord {
+  Addr_t addr = -1;
+  uint32_t is_write = 0;
+  uint32_t reserved = 0;
+};
+static_assert(sizeof(LoadStoreRecord) == 16);
+
+struct InstRecord {
+  Addr_t load_addr = -1;
+  Addr_t store_addr = -1;
+  int32_t bubble_count = 0;
+  uint32_t reserved = 0;
+};
+static_assert(sizeof(InstRecord) == 24);
+
+
+/**
+ * @brief     A read-only memory mapping of a binary trace.
+ *
+ */
+class MappedTrace {
+  private:
+    void* m_data = nullptr;
+    size_t m_size = 0;
+    const TraceHeader* m_header = nullptr;
+
+  public:
+    MappedTrace(const std::filesystem::path& path, TraceKind kind);
+    ~MappedTrace();
+    MappedTrace(const MappedTrace&) = delete;
+    MappedTrace& operator=(const MappedTrace&) = delete;
+
+    const TraceHeader& get_header() const { return *m_header; };
+
+    template <typename T>
+    std::span<const T> get_values(size_t values_per_record = 1) const {
+      return {reinterpret_cast<const T*>(m_header + 1), m_header->num_records * values_per_record};
+    };
+
+    /**
+     * @brief    Whether the file at path starts with the binary trace magic.
+     *
+     */
+    static bool is_binary_trace(const std::filesystem::path& path);
+};
+
+
+/**
+ * @brief     The values of a trace, either parsed from a text trace or mapped from a binary one.
+ *
+ */
+template <typename T>
+class TraceBuffer {
+  private:
+    std::vector<T> m_parsed;
+    std::unique_ptr<MappedTrace> m_mapped;
+    std::span<const T> m_values;
+
+  public:
+    TraceBuffer() = default;
+    explicit TraceBuffer(std::vector<T>&& parsed) : m_parsed(std::move(parsed)), m_values(m_parsed) {};
+    TraceBuffer(std::unique_ptr<MappedTrace> mapped, size_t values_per_record = 1) :
+    m_mapped(std::move(mapped)), m_values(m_mapped->get_values<T>(values_per_record)) {};
+
+    size_t size() const { return m_values.size(); };
+    bool is_mapped() const { return m_mapped != nullptr; };
+    const T& operator[](size_t idx) const { return m_values[idx]; };
+    const T* data() const { return m_values.data(); };
+};
+
+
+/**
+ * @brief     Checks the header of a binary trace of the given kind.
+ *
+ * @return    An empty string if the header is valid, the error otherwise.
+ */
+std::string check_trace_header(const TraceHeader& header, TraceKind kind);
+
+/**
+ * @brief     Parse one line of a text trace.
+ * @details   parse_readwrite_line appends {is_write, addr_vec...} to values.
+ *
+ * @return    false if the line is invalid.
+ */
+bool parse_loadstore_line(const std::string& line, LoadStoreRecord& record);
+bool parse_readwrite_line(const std::string& line, std::vector<int32_t>& values);
+bool parse_inst_line(const std::string& line, InstRecord& record);
+
+/**
+ * @brief     Parse a text trace.
+ *
+ */
+std::vector<LoadStoreRecord> parse_loadstore_trace(const std::filesystem::path& path);
+std::vector<int32_t> parse_readwrite_trace(const std::filesystem::path& path, size_t& num_fields);
+std::vector<InstRecord> parse_inst_trace(const std::filesystem::path& path);
+
+/**
+ * @brief     Load a trace, mapping it if it is binary and parsing it otherwise.
+ * @details   ReadWrite traces are flattened into num_fields + 1 values per record (see TraceHeader).
+ *
+ */
+TraceBuffer<LoadStoreRecord> load_loadstore_trace(const std::filesystem::path& path);
+TraceBuffer<int32_t> load_readwrite_trace(const std::filesystem::path& path, size_t& num_fields);
+TraceBuffer<InstRecord> load_inst_trace(const std::filesystem::path& path);
+
+/**
+ * @brief     Convert a text trace of the given kind ("loadstore", "readwrite", or "inst") into a binary trace.
+ *
+ * @return    The number of records written.
+ */
+size_t convert_trace(const std::string& kind_name, const std::filesystem::path& input_path, const std::filesystem::path& output_path);
+
+}        // namespace Ramulator
+
+
+#endif   // RAMULATOR_FRONTEND_TRACE_FILE_H
@@ -0,0 +1,409 @@
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+
+#ifdef RAMULATOR_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef RAMULATOR_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "base/exception.h"
+#include "frontend/trace_stream.h"
+
+namespace Ramulator {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+enum class Compression {
+  None,
+  Gzip,
+  Zstd,
+};
+
+Compression get_compression(const fs::path& path) {
+  std::ifstream file(path, std::ios::binary);
+  unsigned char magic[4] = {};
+  file.read(reinterpret_cast<char*>(magic), sizeof(magic));
+  if (file.gcount() >= 2 && magic[0] == 0x1f && magic[1] == 0x8b) {
+    return Compression::Gzip;
+  } else if (file.gcount() == 4 && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd) {
+    return Compression::Zstd;
+  }
+  return Compression::None;
+}
+
+bool parse_line(const std::string& line, std::vector<LoadStoreRecord>& values) {
+  LoadStoreRecord record;
+  if (!parse_loadstore_line(line, record)) {
+    return false;
+  }
+  values.push_back(record);
+  return true;
+}
+
+bool parse_line(const std::string& line, std::vector<int32_t>& values) {
+  return parse_readwrite_line(line, values);
+}
+
+bool parse_line(const std::string& line, std::vector<InstRecord>& values) {
+  InstRecord record;
+  if (!parse_inst_line(line, record)) {
+    return false;
+  }
+  values.push_back(record);
+  return true;
+}
+
+}        // namespace
+
+
+/**
+ * @brief     The decompressed bytes of a trace file.
+ *
+ */
+class TraceInput {
+  private:
+    fs::path m_path;
+    Compression m_compression;
+    std::ifstream m_file;         // Raw and zstd-compressed traces
+
+#ifdef RAMULATOR_HAVE_ZLIB
+    gzFile m_gz_file = nullptr;
+#endif
+#ifdef RAMULATOR_HAVE_ZSTD
+    ZSTD_DCtx* m_zstd_ctx = nullptr;
+    std::vector<char> m_compressed;
+    ZSTD_inBuffer m_zstd_input = {nullptr, 0, 0};
+    bool m_is_zstd_frame_done = true;
+#endif
+
+  public:
+    explicit TraceInput(const fs::path& path) : m_path(path) {
+      if (!fs::exists(path)) {
+        throw ConfigurationError("Trace {} does not exist!", path.string());
+      }
+      m_compression = get_compression(path);
+
+      if (m_compression == Compression::Gzip) {
+#ifdef RAMULATOR_HAVE_ZLIB
+        m_gz_file = gzopen(path.c_str(), "rb");
+        if (m_gz_file == nullptr) {
+          throw ConfigurationError("Trace {} cannot be opened!", path.string());
+        }
+        gzbuffer(m_gz_file, 1 << 20);
+        return;
+#else
+        throw ConfigurationError("Trace {} is gzip-compressed but Ramulator was built without zlib!", path.string());
+#endif
+      }
+
+      if (m_compression == Compression::Zstd) {
+#ifdef RAMULATOR_HAVE_ZSTD
+        m_zstd_ctx = ZSTD_createDCtx();
+        m_compressed.resize(ZSTD_DStreamInSize());
+#else
+        throw ConfigurationError("Trace {} is zstd-compressed but Ramulator was built without zstd!", path.string());
+#endif
+      }
+
+      m_file.open(path, std::ios::binary);
+      if (!m_file.is_open()) {
+        throw ConfigurationError("Trace {} cannot be opened!", path.string());
+      }
+    };
+
+    ~TraceInput() {
+#ifdef RAMULATOR_HAVE_ZLIB
+      if (m_gz_file != nullptr) {
+        gzclose(m_gz_file);
+      }
+#endif
+#ifdef RAMULATOR_HAVE_ZSTD
+      ZSTD_freeDCtx(m_zstd_ctx);
+#endif
+    };
+
+    /**
+     * @brief    Reads up to size bytes, fewer only at the end of the trace.
+     *
+     * @return   The number of bytes read.
+     */
+    size_t read(char* data, size_t size) {
+      switch (m_compression) {
+        case Compression::None: {
+          m_file.read(data, size);
+          return m_file.gcount();
+        }
+#ifdef RAMULATOR_HAVE_ZLIB
+        case Compression::Gzip: {
+          size_t total = 0;
+          while (total < size) {
+            int num_bytes = gzread(m_gz_file, data + total, std::min<size_t>(size - total, 1u << 30));
+            int errnum = Z_OK;
+            const char* error = gzerror(m_gz_file, &errnum);
+            if (num_bytes < 0 || errnum != Z_OK) {
+              throw ConfigurationError("Trace {} cannot be decompressed: {}!", m_path.string(), error);
+            } else if (num_bytes == 0) {
+              break;
+            }
+            total += num_bytes;
+          }
+          return total;
+        }
+#endif
+#ifdef RAMULATOR_HAVE_ZSTD
+        case Compression::Zstd: {
+          ZSTD_outBuffer output = {data, size, 0};
+          while (output.pos < size) {
+            if (m_zstd_input.pos == m_zstd_input.size) {
+              m_file.read(m_compressed.data(), m_compressed.size());
+              m_zstd_input = {m_compressed.data(), static_cast<size_t>(m_file.gcount()), 0};
+              if (m_zstd_input.size == 0) {
+                if (!m_is_zstd_frame_done) {
+                  throw ConfigurationError("Trace {} cannot be decompressed: unexpected end of file!", m_path.string());
+                }
+                break;
+              }
+            }
+            size_t ret = ZSTD_decompressStream(m_zstd_ctx, &output, &m_zstd_input);
+            if (ZSTD_isError(ret)) {
+              throw ConfigurationError("Trace {} cannot be decompressed: {}!", m_path.string(), ZSTD_getErrorName(ret));
+            }
+            // 0 once a frame is completely decoded and flushed
+            m_is_zstd_frame_done = ret == 0;
+          }
+          return output.pos;
+        }
+#endif
+        default:
+          return 0;
+      }
+    };
+
+    void rewind() {
+#ifdef RAMULATOR_HAVE_ZLIB
+      if (m_compression == Compression::Gzip) {
+        gzrewind(m_gz_file);
+        return;
+      }
+#endif
+#ifdef RAMULATOR_HAVE_ZSTD
+      if (m_compression == Compression::Zstd) {
+        ZSTD_DCtx_reset(m_zstd_ctx, ZSTD_reset_session_only);
+        m_zstd_input = {nullptr, 0, 0};
+        m_is_zstd_frame_done = true;
+      }
+#endif
+      m_file.clear();
+      m_file.seekg(0);
+    };
+};
+
+
+template <typename T>
+TraceStream<T>::TraceStream(const fs::path& path, TraceKind kind) :
+m_path(path), m_kind(kind), m_input(std::make_unique<TraceInput>(path)) {
+  m_reader = std::thread([this]() { reader_loop(); });
+}
+
+template <typename T>
+TraceStream<T>::~TraceStream() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop_reader = true;
+  }
+  m_cv.notify_all();
+  m_reader.join();
+}
+
+template <typename T>
+void TraceStream<T>::advance_head() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if (m_has_head) {
+    // The consumed block is free for the reader thread again
+    m_num_full--;
+    m_head = (m_head + 1) % NumBlocks;
+    m_cv.notify_all();
+  }
+  m_cv.wait(lock, [this]() { return m_num_full > 0 || m_error; });
+  if (m_num_full == 0) {
+    std::rethrow_exception(m_error);
+  }
+  m_has_head = true;
+  m_curr_record = 0;
+}
+
+template <typename T>
+void TraceStream<T>::reader_loop() {
+  try {
+    std::vector<char> header_bytes(sizeof(TraceHeader));
+    while (true) {
+      size_t num_bytes = m_input->read(header_bytes.data(), header_bytes.size());
+      const TraceHeader* header = reinterpret_cast<const TraceHeader*>(header_bytes.data());
+
+      size_t num_records = 0;
+      bool is_binary = num_bytes == sizeof(TraceHeader) && std::memcmp(header->magic, TraceHeader::Magic, sizeof(TraceHeader::Magic)) == 0;
+      bool is_done = is_binary ? read_binary_pass(*header, num_records) : read_text_pass(header_bytes.data(), num_bytes, num_records);
+      if (!is_done) {
+        return;
+      }
+      if (num_records == 0) {
+        throw ConfigurationError("Trace {} is empty!", m_path.string());
+      }
+      m_num_records = num_records;
+      m_input->rewind();
+    }
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_error = std::current_exception();
+    m_cv.notify_all();
+  }
+}
+
+template <typename T>
+bool TraceStream<T>::read_binary_pass(const TraceHeader& header, size_t& num_records) {
+  std::string error = check_trace_header(header, m_kind);
+  if (!error.empty()) {
+    throw ConfigurationError("Binary trace {} is invalid: {}!", m_path.string(), error);
+  }
+  if (m_values_per_record == 0) {
+    m_values_per_record = header.record_size / sizeof(T);
+  }
+
+  while (num_records < header.num_records) {
+    Block* block = acquire_tail();
+    if (block == nullptr) {
+      return false;
+    }
+    size_t block_records = std::min<size_t>(BlockSize, header.num_records - num_records);
+    block->values.resize(block_records * m_values_per_record);
+    size_t num_bytes = block_records * header.record_size;
+    if (m_input->read(reinterpret_cast<char*>(block->values.data()), num_bytes) != num_bytes) {
+      throw ConfigurationError("Binary trace {} is invalid: the trace is truncated!", m_path.string());
+    }
+    block->num_records = block_records;
+    num_records += block_records;
+    hand_over_tail();
+  }
+  return true;
+}
+
+template <typename T>
+bool TraceStream<T>::read_text_pass(const char* data, size_t size, size_t& num_records) {
+  Block* block = nullptr;
+  size_t line_number = 0;
+  auto add_line = [&](const std::string& line) {
+    if (block == nullptr && (block = acquire_tail()) == nullptr) {
+      return false;
+    }
+    line_number++;
+    size_t num_values = block->values.size();
+    if (!parse_line(line, block->values)) {
+      throw ConfigurationError("Trace {} format invalid at line {}!", m_path.string(), line_number);
+    }
+    size_t line_num_values = block->values.size() - num_values;
+    if (m_values_per_record == 0) {
+      m_values_per_record = line_num_values;
+    } else if (line_num_values != m_values_per_record) {
+      throw ConfigurationError("Trace {} has an address vector of {} levels at line {} (expected {})!", m_path.string(), line_num_values - 1, line_number, m_values_per_record - 1);
+    }
+    num_records++;
+    if (++block->num_records == BlockSize) {
+      hand_over_tail();
+      block = nullptr;
+    }
+    return true;
+  };
+
+  // Lines can span chunks, the start of a line is kept until its end is read
+  std::string line;
+  std::vector<char> chunk(ChunkSize);
+  while (size > 0) {
+    size_t start = 0;
+    while (const void* newline = std::memchr(data + start, '\n', size - start)) {
+      size_t end = static_cast<const char*>(newline) - data;
+      line.append(data + start, end - start);
+      if (!add_line(line)) {
+        return false;
+      }
+      line.clear();
+      start = end + 1;
+    }
+    line.append(data + start, size - start);
+
+    size = m_input->read(chunk.data(), chunk.size());
+    data = chunk.data();
+  }
+  if (!line.empty() && !add_line(line)) {
+    return false;
+  }
+
+  if (block != nullptr) {
+    hand_over_tail();
+  }
+  return true;
+}
+
+template <typename T>
+typename TraceStream<T>::Block* TraceStream<T>::acquire_tail() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_cv.wait(lock, [this]() { return m_num_full < NumBlocks || m_stop_reader; });
+  if (m_stop_reader) {
+    return nullptr;
+  }
+  Block* block = &m_blocks[m_tail];
+  lock.unlock();
+
+  block->values.clear();
+  block->values.reserve(BlockSize * std::max<size_t>(m_values_per_record, 1));
+  block->num_records = 0;
+  return block;
+}
+
+template <typename T>
+void TraceStream<T>::hand_over_tail() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_tail = (m_tail + 1) % NumBlocks;
+    m_num_full++;
+  }
+  m_cv.notify_all();
+}
+
+template class TraceStream<LoadStoreRecord>;
+template class TraceStream<int32_t>;
+template class TraceStream<InstRecord>;
+
+
+bool is_compressed_trace(const fs::path& path) {
+  return get_compression(path) != Compression::None;
+}
+
+TraceReader<LoadStoreRecord> open_loadstore_trace(const fs::path& path, bool streaming) {
+  if (streaming || is_compressed_trace(path)) {
+    return TraceReader<LoadStoreRecord>(std::make_unique<TraceStream<LoadStoreRecord>>(path, TraceKind::LoadStore));
+  }
+  return TraceReader<LoadStoreRecord>(load_loadstore_trace(path));
+}
+
+TraceReader<int32_t> open_readwrite_trace(const fs::path& path, bool streaming) {
+  if (streaming || is_compressed_trace(path)) {
+    return TraceReader<int32_t>(std::make_unique<TraceStream<int32_t>>(path, TraceKind::ReadWrite));
+  }
+  size_t num_fields = 0;
+  TraceBuffer<int32_t> buffer = load_readwrite_trace(path, num_fields);
+  return TraceReader<int32_t>(std::move(buffer), num_fields + 1);
+}
+
+TraceReader<InstRecord> open_inst_trace(const fs::path& path, bool streaming) {
+  if (streaming || is_compressed_trace(path)) {
+    return TraceReader<InstRecord>(std::make_unique<TraceStream<InstRecord>>(path, TraceKind::Inst));
+  }
+  return TraceReader<InstRecord>(load_inst_trace(path));
+}
+
+}        // namespace Ramulator
@@ -0,0 +1,169 @@
+#ifndef     RAMULATOR_FRONTEND_TRACE_STREAM_H
+#define     RAMULATOR_FRONTEND_TRACE_STREAM_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <filesystem>
+
+#include "frontend/trace_file.h"
+
+namespace Ramulator {
+
+class TraceInput;
+
+/**
+ * @brief     Reads a trace on a background thread so that only a few blocks of it are in memory at a time.
+ * @details
+ * The trace can be a text or binary trace (see TraceHeader), either raw or gzip/zstd-compressed (detected from its
+ * first bytes). The reader thread decompresses and parses the trace into a ring of NumBlocks blocks of BlockSize
+ * records, and waits while all of them are full. The simulation only waits if it consumes a whole block before the
+ * reader has filled the next one. Like the in-memory traces, the stream starts over at the end of the trace.
+ *
+ * Errors found by the reader thread are thrown by next() once the records before them have been consumed.
+ *
+ */
+template <typename T>
+class TraceStream {
+  public:
+    static constexpr size_t BlockSize = 65536;    // Records per block
+    static constexpr size_t NumBlocks = 4;
+    static constexpr size_t ChunkSize = 1 << 20;  // Bytes read from the (decompressed) trace at a time
+
+  private:
+    struct Block {
+      std::vector<T> values;
+      size_t num_records = 0;
+    };
+
+    std::filesystem::path m_path;
+    TraceKind m_kind;
+    std::unique_ptr<TraceInput> m_input;
+
+    size_t m_values_per_record = 0;         // Set by the reader thread before it hands over the first block
+    std::atomic<size_t> m_num_records = 0;  // 0 until the reader thread has reached the end of the trace
+
+    Block m_blocks[NumBlocks];
+    size_t m_head = 0;                      // The block being consumed
+    size_t m_tail = 0;                      // The block being filled by the reader thread
+    size_t m_num_full = 0;                  // Blocks handed over and not yet consumed, including the head
+    bool m_has_head = false;
+    size_t m_curr_record = 0;
+
+    std::thread m_reader;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_stop_reader = false;
+    std::exception_ptr m_error;
+
+  public:
+    TraceStream(const std::filesystem::path& path, TraceKind kind);
+    ~TraceStream();
+    TraceStream(const TraceStream&) = delete;
+    TraceStream& operator=(const TraceStream&) = delete;
+
+    /**
+     * @brief    Returns the next record, which stays valid until the next call.
+     *
+     */
+    const T* next() {
+      if (!m_has_head || m_curr_record == m_blocks[m_head].num_records) {
+        advance_head();
+      }
+      return m_blocks[m_head].values.data() + m_values_per_record * m_curr_record++;
+    };
+
+    /**
+     * @brief    The number of records in the trace, 0 if the reader thread has not reached its end yet.
+     *
+     */
+    size_t get_num_records() const { return m_num_records; };
+
+    /**
+     * @brief    The number of values per record (num_fields + 1 for ReadWrite traces), waits for the first block.
+     *
+     */
+    size_t get_values_per_record() {
+      if (!m_has_head) {
+        advance_head();
+      }
+      return m_values_per_record;
+    };
+
+  private:
+    void advance_head();
+
+    void reader_loop();
+    bool read_binary_pass(const TraceHeader& header, size_t& num_records);
+    bool read_text_pass(const char* data, size_t size, size_t& num_records);
+    Block* acquire_tail();
+    void hand_over_tail();
+};
+
+
+/**
+ * @brief     Reads the records of a trace in order (wrapping around at the end), whether it is streamed or in memory.
+ *
+ */
+template <typename T>
+class TraceReader {
+  private:
+    TraceBuffer<T> m_buffer;
+    std::unique_ptr<TraceStream<T>> m_stream;
+    size_t m_values_per_record = 1;
+    size_t m_num_records = 0;
+    size_t m_curr_record = 0;
+
+  public:
+    TraceReader() = default;
+    TraceReader(TraceBuffer<T>&& buffer, size_t values_per_record = 1) :
+    m_buffer(std::move(buffer)), m_values_per_record(values_per_record), m_num_records(m_buffer.size() / values_per_record) {};
+    explicit TraceReader(std::unique_ptr<TraceStream<T>> stream) : m_stream(std::move(stream)) {};
+
+    /**
+     * @brief    Returns the next record, which stays valid until the next call.
+     *
+     */
+    const T* next() {
+      if (m_stream) {
+        return m_stream->next();
+      }
+      const T* record = m_buffer.data() + m_curr_record * m_values_per_record;
+      m_curr_record = (m_curr_record + 1) % m_num_records;
+      return record;
+    };
+
+    bool is_streamed() const { return m_stream != nullptr; };
+
+    /**
+     * @brief    The number of records in the trace, 0 if it is streamed and its end has not been reached yet.
+     *
+     */
+    size_t get_num_records() const { return m_stream ? m_stream->get_num_records() : m_num_records; };
+    size_t get_values_per_record() { return m_stream ? m_stream->get_values_per_record() : m_values_per_record; };
+};
+
+
+/**
+ * @brief     Whether the file at path is gzip- or zstd-compressed.
+ *
+ */
+bool is_compressed_trace(const std::filesystem::path& path);
+
+/**
+ * @brief     Open a trace, streaming it if requested or if it is compressed, and loading it otherwise (see load_*_trace).
+ *
+ */
+TraceReader<LoadStoreRecord> open_loadstore_trace(const std::filesystem::path& path, bool streaming);
+TraceReader<int32_t> open_readwrite_trace(const std::filesystem::path& path, bool streaming);
+TraceReader<InstRecord> open_inst_trace(const std::filesystem::path& path, bool streaming);
+
+}        // namespace Ramulator
+
+
+#endif   // RAMULATOR_FRONTEND_TRACE_STREAM_H
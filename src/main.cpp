@@ -6,11 +6,33 @@
 
 #include "base/base.h"
 #include "base/config.h"
+#include "base/stats_sink.h"
 #include "frontend/frontend.h"
+#include "frontend/trace_file.h"
 #include "memory_system/memory_system.h"
 #include "example/example_ifce.h"
 
+int trace_convert(int argc, char* argv[]) {
+  if (argc != 5) {
+    std::cerr << "Usage: " << argv[0] << " trace-convert <loadstore|readwrite|inst> <input text trace> <output binary trace>" << std::endl;
+    return 1;
+  }
+  try {
+    size_t num_records = Ramulator::convert_trace(argv[2], argv[3], argv[4]);
+    spdlog::info("Converted {} records from {} to {}.", num_records, argv[3], argv[4]);
+  } catch (const std::exception& err) {
+    spdlog::error(err.what());
+    return 1;
+  }
+  return 0;
+}
+
 int main(int argc, char* argv[]) {
+  // Convert a text trace to the binary trace format, e.g., "ramulator2 trace-convert inst <input> <output>"
+  if (argc > 1 && std::string(argv[1]) == "trace-convert") {
+    return trace_convert(argc, argv);
+  }
+
   // Parse command line arguments
   argparse::ArgumentParser program("Ramulator", "2.0");
   program.add_argument("-c", "--config").metavar("\"dumped YAML configuration\"")
@@ -20,6 +42,10 @@ int main(int argc, char* argv[]) {
   program.add_argument("-p", "--param").metavar("KEY=VALUE")
     .append()
     .help("Specify parameter to override in the configuration file. Repeat this option to change multiple parameters.");
+  program.add_argument("--stats_file").metavar("path-to-stats-file")
+    .help("Also write the statistics to a file in a machine-readable format.");
+  program.add_argument("--stats_format").metavar("json|csv|binary")
+    .help("Format of the statistics file (default: json).");
 
   try {
     program.parse_args(argc, argv);
@@ -68,6 +94,16 @@ int main(int argc, char* argv[]) {
   if (use_dumped_yaml && has_param_override) {
     spdlog::warn("Using dumped configuration. Parameter overrides with -p/--param will be ignored!");
   }
+
+  // Are we writing the statistics to a file as well?
+  std::string stats_file_path;
+  std::unique_ptr<Ramulator::IStatsSink> stats_sink;
+  if (auto arg = program.present<std::string>("--stats_file")) {
+    stats_file_path = *arg;
+    stats_sink = Ramulator::IStatsSink::create(program.present<std::string>("--stats_format").value_or("json"));
+  } else if (program.present<std::string>("--stats_format")) {
+    spdlog::warn("No statistics file specified with --stats_file. --stats_format will be ignored!");
+  }
   
   // Parse the configurations
   YAML::Node config;
@@ -97,9 +133,30 @@ int main(int argc, char* argv[]) {
 
   int tick_mult = frontend_tick * mem_tick;
 
+  // The number of ticks each side has received so far (i.e., their own clock cycles)
+  Ramulator::Clk_t frontend_cycles = 0;
+  Ramulator::Clk_t memory_cycles = 0;
+
   for (uint64_t i = 0;; i++) {
+    // At the start of every tick period, skip the periods in which neither side has anything to do
+    if ((i % tick_mult) == 0) {
+      // Ask the frontend first, as the memory system may have to look at all of its buffered requests
+      Ramulator::Clk_t num_periods = (frontend->get_next_event_cycle() - 1 - frontend_cycles) / frontend_tick;
+      if (num_periods > 0) {
+        num_periods = std::min(num_periods, (memory_system->get_next_event_cycle() - 1 - memory_cycles) / mem_tick);
+      }
+      if (num_periods > 0) {
+        frontend->fast_forward(num_periods * frontend_tick);
+        memory_system->fast_forward(num_periods * mem_tick);
+        frontend_cycles += num_periods * frontend_tick;
+        memory_cycles += num_periods * mem_tick;
+        i += num_periods * tick_mult;
+      }
+    }
+
     if (((i % tick_mult) % mem_tick) == 0) {
       frontend->tick();
+      frontend_cycles++;
     }
 
     if (frontend->is_finished()) {
@@ -108,6 +165,7 @@ int main(int argc, char* argv[]) {
 
     if ((i % tick_mult) % frontend_tick == 0) {
       memory_system->tick();
+      memory_cycles++;
     }
   }
 
@@ -115,5 +173,11 @@ int main(int argc, char* argv[]) {
   frontend->finalize();
   memory_system->finalize();
 
+  if (stats_sink) {
+    frontend->m_impl->emit_stats(*stats_sink);
+    memory_system->m_impl->emit_stats(*stats_sink);
+    stats_sink->save(stats_file_path);
+  }
+
   return 0;
 }
\ No newline at end of file
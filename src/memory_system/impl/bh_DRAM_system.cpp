@@ -23,7 +23,7 @@ class BHDRAMSystem final : public IBHMemorySystem, public Implementation {
 
   public:
     bool is_finished_ms() override {return true;};
-    bool is_request_finished(Request req) override {return true;};
+    bool is_request_finished(const Request& req) override {return true;};
     int get_total_address_bits() override { return 0; };
     int get_shift_amt(int idx) override { return -1; };
     size_t get_max(int idx) override { return -1; };
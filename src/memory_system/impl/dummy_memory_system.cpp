@@ -7,7 +7,7 @@ class DummyMemorySystem final : public IMemorySystem, public Implementation {
 
   public:
     bool is_finished_ms() override {return true;};
-    bool is_request_finished(Request req) override {return true;};
+    bool is_request_finished(const Request& req) override {return true;};
     int get_total_address_bits() override { return 0; };
     int get_shift_amt(int idx) override { return -1; };
     size_t get_max(int idx) override { return -1; };
@@ -27,6 +27,10 @@ class DummyMemorySystem final : public IMemorySystem, public Implementation {
     };
 
     void tick() override {};
+
+    Clk_t get_next_event_cycle() override { return NEVER_CLK; };
+
+    void fast_forward(Clk_t num_cycles) override {};
 };
   
 }   // namespace Ramulator
\ No newline at end of file
@@ -1,3 +1,7 @@
+#include <atomic>
+#include <thread>
+
+#include "base/epoch_stats.h"
 #include "memory_system/memory_system.h"
 #include "translation/translation.h"
 #include "dram_controller/controller.h"
@@ -15,6 +19,30 @@ class GenericDRAMSystem final : public IMemorySystem, public Implementation {
     IAddrMapper*  m_addr_mapper;
     std::vector<IDRAMController*> m_controllers;
 
+    /**
+     * @brief    Ticks the controllers of different channels on a pool of worker threads.
+     * @details
+     * Controllers of different channels only share the DRAM device (whose nodes are per channel) and the 
+     * frontend callbacks. Every memory cycle, the device is ticked first, then each thread ticks a fixed, 
+     * contiguous group of channels, and all threads meet at a spinning barrier. Callbacks to the frontend 
+     * are deferred to the barrier and delivered in channel order, so results do not depend on the number of threads.
+     */
+    int m_num_threads = 1;
+    std::vector<std::thread> m_workers;
+    std::vector<std::pair<int, int>> m_thread_channels;    // [first, last) channel ticked by each thread
+    std::atomic<uint64_t> m_tick_generation = 0;           // Bumped by the main thread to start a parallel tick
+    std::atomic<int> m_num_workers_done = 0;               // Number of workers that finished the current tick
+    std::atomic<bool> m_stop_workers = false;
+
+    std::vector<std::vector<Request>> m_deferred_callbacks;   // Requests served during a parallel tick, per channel
+
+    Clk_t m_epoch_interval = 0;                                // Sample the epoch stats every this many cycles (0 to disable)
+    std::string m_epoch_path;
+    std::string m_epoch_format;
+    std::vector<std::string> m_epoch_delta_stats;
+    std::vector<std::string> m_epoch_gauge_stats;
+    EpochStats m_epoch_stats;
+
   public:
     int s_num_read_requests = 0;
     int s_num_write_requests = 0;
@@ -36,7 +64,7 @@ class GenericDRAMSystem final : public IMemorySystem, public Implementation {
       return true;
     }
 
-    bool is_request_finished(Request req) override {
+    bool is_request_finished(const Request& req) override {
       bool in_read = false;
       bool in_active = false;
       for (auto controller: m_controllers) {
@@ -143,6 +171,26 @@ class GenericDRAMSystem final : public IMemorySystem, public Implementation {
 
       m_clock_ratio = param<uint>("clock_ratio").required();
 
+      m_num_threads = param<int>("num_threads").desc("Number of threads ticking the channel controllers in parallel.").default_val(1);
+      if (m_num_threads < 1) {
+        throw ConfigurationError("The number of threads of {} must be at least 1!", get_name());
+      }
+      m_num_threads = std::min(m_num_threads, num_channels);
+      if (m_num_threads > 1) {
+        start_workers();
+      }
+
+      m_epoch_interval = param<Clk_t>("epoch_interval").desc("Sample the epoch stats every this many memory cycles (0 to disable).").default_val(0);
+      if (m_epoch_interval < 0) {
+        throw ConfigurationError("Invalid epoch_interval ({}) in {}!", m_epoch_interval, get_name());
+      }
+      if (m_epoch_interval > 0) {
+        m_epoch_path = param<std::string>("epoch_path").desc("Path to the epoch stats file.").required();
+        m_epoch_format = param<std::string>("epoch_format").desc("Format of the epoch stats file (csv or binary).").default_val("csv");
+        m_epoch_delta_stats = param<std::vector<std::string>>("epoch_delta_stats").desc("Stats sampled as their change over each epoch (a trailing * matches by prefix).").default_val({});
+        m_epoch_gauge_stats = param<std::vector<std::string>>("epoch_gauge_stats").desc("Stats sampled as their value at the end of each epoch (a trailing * matches by prefix).").default_val({});
+      }
+
       register_stat(m_clk).name("memory_system_cycles");
       register_stat(s_num_read_requests).name("total_num_read_requests");
       register_stat(s_num_write_requests).name("total_num_write_requests");
@@ -151,6 +199,25 @@ class GenericDRAMSystem final : public IMemorySystem, public Implementation {
 
     void setup(IFrontEnd* frontend, IMemorySystem* memory_system) override { }
 
+    void connect_frontend(IFrontEnd* frontend) override {
+      IMemorySystem::connect_frontend(frontend);
+      if (m_epoch_interval > 0) {
+        // Components register their stats in setup(), so the stats can only be looked up now
+        setup_epoch_stats(frontend);
+      }
+    };
+
+    void finalize() override {
+      if (m_epoch_interval > 0) {
+        m_epoch_stats.close(m_clk);
+      }
+      IMemorySystem::finalize();
+    };
+
+    ~GenericDRAMSystem() {
+      stop_workers();
+    };
+
     bool send(Request req) override {
       m_addr_mapper->apply(req);
       int channel_id = req.addr_vec[0];
@@ -179,8 +246,39 @@ class GenericDRAMSystem final : public IMemorySystem, public Implementation {
     void tick() override {
       m_clk++;
       m_dram->tick();
+      if (m_num_threads > 1) {
+        tick_parallel();
+      } else {
+        for (auto controller : m_controllers) {
+          controller->tick();
+        }
+      }
+
+      if (m_epoch_interval > 0 && m_clk % m_epoch_interval == 0) {
+        m_epoch_stats.sample(m_clk);
+      }
+    };
+
+    Clk_t get_next_event_cycle() override {
+      Clk_t next_event_cycle = NEVER_CLK;
       for (auto controller : m_controllers) {
-        controller->tick();
+        next_event_cycle = std::min(next_event_cycle, controller->get_next_event_cycle());
+        if (next_event_cycle <= m_clk + 1) {
+          // Some controller is busy, no need to look further
+          return next_event_cycle;
+        }
+      }
+      if (m_epoch_interval > 0) {
+        next_event_cycle = std::min(next_event_cycle, (m_clk / m_epoch_interval + 1) * m_epoch_interval);
+      }
+      return std::min(next_event_cycle, m_dram->get_next_event_cycle());
+    };
+
+    void fast_forward(Clk_t num_cycles) override {
+      m_clk += num_cycles;
+      m_dram->fast_forward(num_cycles);
+      for (auto controller : m_controllers) {
+        controller->fast_forward(num_cycles);
       }
     };
 
@@ -188,6 +286,105 @@ class GenericDRAMSystem final : public IMemorySystem, public Implementation {
       return m_dram->m_timing_vals("tCK_ps") / 1000.0f;
     }
 
+  private:
+    void setup_epoch_stats(IFrontEnd* frontend) {
+      std::vector<Implementation*> impls = {frontend->m_impl};
+      impls.insert(impls.end(), frontend->get_components().begin(), frontend->get_components().end());
+      impls.push_back(this);
+      impls.insert(impls.end(), get_components().begin(), get_components().end());
+
+      for (bool is_delta : {true, false}) {
+        for (const auto& pattern : is_delta ? m_epoch_delta_stats : m_epoch_gauge_stats) {
+          int num_matches = 0;
+          for (auto impl : impls) {
+            std::string prefix = impl->get_ifce_name();
+            if (impl->get_id() != "_default_id") {
+              prefix += fmt::format("[{}]", impl->get_id());
+            }
+            num_matches += m_epoch_stats.add_stats(impl->get_stats(), prefix, pattern, is_delta);
+          }
+          if (num_matches == 0) {
+            throw ConfigurationError("No stat matches \"{}\" in the epoch stats of {}!", pattern, get_name());
+          }
+        }
+      }
+      m_epoch_stats.open(m_epoch_path, m_epoch_format);
+    };
+
+    void start_workers() {
+      int num_channels = m_controllers.size();
+      m_deferred_callbacks.resize(num_channels);
+      for (int ch = 0; ch < num_channels; ch++) {
+        // Controllers tick on worker threads, hold their callbacks until all channels are ticked
+        m_controllers[ch]->defer_callbacks(&m_deferred_callbacks[ch]);
+      }
+      for (int t = 0; t < m_num_threads; t++) {
+        m_thread_channels.push_back({t * num_channels / m_num_threads, (t + 1) * num_channels / m_num_threads});
+      }
+      // The main thread ticks the first group of channels itself
+      for (int t = 1; t < m_num_threads; t++) {
+        m_workers.emplace_back([this, t]() { worker_loop(t); });
+      }
+    };
+
+    void stop_workers() {
+      m_stop_workers.store(true, std::memory_order_release);
+      m_tick_generation.fetch_add(1, std::memory_order_release);
+      for (auto& worker : m_workers) {
+        worker.join();
+      }
+      m_workers.clear();
+    };
+
+    void tick_channels(int thread_id) {
+      auto [first, last] = m_thread_channels[thread_id];
+      for (int ch = first; ch < last; ch++) {
+        m_controllers[ch]->tick();
+      }
+    };
+
+    // Spin for a while before giving up the core, as memory ticks are usually much shorter than a time slice
+    static void spin_wait(int& num_spins) {
+      if (++num_spins > 1024) {
+        std::this_thread::yield();
+      }
+    };
+
+    void worker_loop(int thread_id) {
+      uint64_t generation = 0;
+      while (true) {
+        int num_spins = 0;
+        while (m_tick_generation.load(std::memory_order_acquire) == generation) {
+          spin_wait(num_spins);
+        }
+        generation++;
+        if (m_stop_workers.load(std::memory_order_acquire)) {
+          return;
+        }
+        tick_channels(thread_id);
+        m_num_workers_done.fetch_add(1, std::memory_order_release);
+      }
+    };
+
+    void tick_parallel() {
+      m_num_workers_done.store(0, std::memory_order_relaxed);
+      m_tick_generation.fetch_add(1, std::memory_order_release);
+      tick_channels(0);
+
+      int num_spins = 0;
+      while (m_num_workers_done.load(std::memory_order_acquire) != m_num_threads - 1) {
+        spin_wait(num_spins);
+      }
+
+      // Deliver the callbacks in the same order as a serial tick would
+      for (auto& served_reqs : m_deferred_callbacks) {
+        for (auto& req : served_reqs) {
+          req.callback(req);
+        }
+        served_reqs.clear();
+      }
+    };
+
     // const SpecDef& get_supported_requests() override {
     //   return m_dram->m_requests;
     // };
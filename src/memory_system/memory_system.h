@@ -22,7 +22,7 @@ class IMemorySystem : public TopLevel<IMemorySystem> {
 
   public:
     virtual bool is_finished_ms() = 0;
-    virtual bool is_request_finished(Request req) = 0;
+    virtual bool is_request_finished(const Request& req) = 0;
     virtual int get_total_address_bits() = 0;
     virtual int get_shift_amt(int idx) = 0;
     virtual size_t get_max(int idx) = 0;
@@ -63,6 +63,25 @@ class IMemorySystem : public TopLevel<IMemorySystem> {
      */
     virtual void tick() = 0;
 
+    /**
+     * @brief    Returns the earliest memory system cycle at which tick() may do more than advancing the clock.
+     * @details
+     * Cycles are counted in memory system ticks. A cycle that is not in the future (e.g., 0, the default)
+     * disables fast-forwarding over the memory system.
+     * 
+     */
+    virtual Clk_t get_next_event_cycle() { return 0; };
+
+    /**
+     * @brief    Advances the memory system by num_cycles ticks that are known to be idle (see get_next_event_cycle()).
+     * 
+     */
+    virtual void fast_forward(Clk_t num_cycles) {
+      for (Clk_t i = 0; i < num_cycles; i++) {
+        tick();
+      }
+    };
+
     /**
      * @brief    Returns 
      * 